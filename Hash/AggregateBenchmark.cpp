@@ -0,0 +1,85 @@
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+#include "HashAggregate.cpp"
+#include "HashMap.hpp"
+
+/*
+
+A GROUP BY throughput benchmark: one HashMap from key to aggregate on one
+thread (the way it is done today) vs HashAggregate with 1 to 16 threads.
+
+Build it with optimizations and threads turned on, for example:
+
+  g++ -std=c++17 -O2 -pthread AggregateBenchmark.cpp -o AggregateBenchmark
+
+10M rows with random keys and values, once with 1K distinct keys (the tables
+stay in the cache) and once with 1M distinct keys (they do not). We report
+millions of rows per second.
+
+*/
+
+using Clock = std::chrono::steady_clock;
+
+const int ROWS = 10000000;
+
+// returns millions of rows per second
+template <typename F>
+double rowsPerSecond(F f) {
+  Clock::time_point start = Clock::now();
+  size_t groups = f();
+  Clock::time_point end = Clock::now();
+
+  // keeps the compiler from dropping the work
+  if (groups == 0) {
+    cout << "no groups?\n";
+  }
+  double seconds = std::chrono::duration<double>(end - start).count();
+  return ROWS / seconds / 1e6;
+}
+
+int main() {
+  int cores = (int)std::thread::hardware_concurrency();
+  cout << "\n==== GROUP BY throughput (million rows/sec) ====\n";
+  cout << "hardware threads: " << cores << ", rows: " << ROWS << "\n";
+
+  std::vector<int> keys(ROWS);
+  std::vector<long long> values(ROWS);
+  const int groupCounts[] = {1000, 1000000};
+
+  for (int groups : groupCounts) {
+    // a tiny xorshift generator, so that every run uses the same rows
+    unsigned long long state = 88172645463325252ULL;
+    for (int i = 0; i < ROWS; i++) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      keys[i] = (int)(state % groups);
+      values[i] = (long long)(state >> 40);
+    }
+
+    cout << "\n" << groups << " groups\n";
+    double single = rowsPerSecond([&]() {
+      HashMap<int, Aggregate> map;
+      for (int i = 0; i < ROWS; i++) {
+        map[keys[i]].add(values[i]);
+      }
+      return map.size();
+    });
+    cout << std::fixed << std::setprecision(1) << "  one HashMap   "
+         << std::setw(8) << single << "\n";
+
+    for (int threads = 1; threads <= 16; threads *= 2) {
+      HashAggregate groupBy(threads);
+      double parallel = rowsPerSecond([&]() {
+        return groupBy.run(keys.data(), values.data(), ROWS).size();
+      });
+      cout << "  " << std::setw(2) << threads << " threads    " << std::setw(8)
+           << parallel << "\n";
+    }
+  }
+  cout << "\n";
+
+  return 0;
+}
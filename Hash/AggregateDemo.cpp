@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <iomanip>
+
+#include "HashAggregate.cpp"
+
+int main() {
+  // declaration
+  int keys[] = {3, 7, 3, 9, 7, 3};
+  long long values[] = {10, 5, 20, 1, 5, 30};
+
+  HashAggregate groupBy(2);
+  std::vector<Group> groups = groupBy.run(keys, values, 6);
+
+  // the groups come out in hash order, sort them to print them
+  std::sort(groups.begin(), groups.end(),
+            [](const Group& a, const Group& b) { return a.key < b.key; });
+
+  cout << "\n  key   sum  count  min  max\n";
+  for (const Group& group : groups) {
+    cout << std::setw(5) << group.key << std::setw(6) << group.agg.sum
+         << std::setw(7) << group.agg.count << std::setw(5) << group.agg.min
+         << std::setw(5) << group.agg.max << "\n";
+  }
+
+  // a bigger column: 1M rows, key i % 1000 and value i
+  const int n = 1000000;
+  std::vector<int> manyKeys(n);
+  std::vector<long long> manyValues(n);
+  for (int i = 0; i < n; i++) {
+    manyKeys[i] = i % 1000;
+    manyValues[i] = i;
+  }
+
+  HashAggregate parallel(4);
+  groups = parallel.run(manyKeys.data(), manyValues.data(), n);
+  long long total = 0;
+  for (const Group& group : groups) {
+    total += group.agg.count;
+  }
+  cout << "\n" << n << " rows, " << parallel.getThreads() << " threads: "
+       << groups.size() << " groups, " << total << " rows counted\n\n";
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+  key   sum  count  min  max
+    3    60      3   10   30
+    7    10      2    5    5
+    9     1      1    1    1
+
+1000000 rows, 4 threads: 1000 groups, 1000000 rows counted
+
+*/
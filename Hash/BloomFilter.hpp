@@ -0,0 +1,102 @@
+#ifndef BLOOM_FILTER
+#define BLOOM_FILTER
+
+#include <cstdint>
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+/*
+
+A Bloom Filter answers "is this key in the set?" with either "definitely not"
+or "maybe". It never forgets a key that was added, but it may say "maybe" for a
+key that was never added (a false positive).
+
+It is an array of bits. Adding a key sets K bits picked by hashing the key;
+checking a key looks at the same K bits. If any of them is 0, the key was never
+added.
+
+  add 12:   bits 3, 9, 14 are set
+  add 40:   bits 1, 9, 20 are set
+
+        0 1 2 3 4 5 6 7 8 9 ...  14 ...  20
+  bits  0 1 0 1 0 0 0 0 0 1      1       1
+
+  check 7:  bits 3, 5, 20  --> bit 5 is 0, 7 is definitely not there
+  check 33: bits 1, 14, 20 --> all 1, "maybe" (a false positive!)
+
+Blocked Bloom Filter:
+In a plain Bloom filter, the K bits of a key are spread over the whole array,
+so one check can miss the cache K times. A blocked filter first picks one block
+of 512 bits (64 bytes, one cache line), and then puts all K bits of the key in
+that block. A check costs at most one cache miss. It has a slightly higher false
+positive rate than a plain filter of the same size, so we use a few more bits
+per key.
+
+  block 0           block 1           block 2
+  +---------------+ +---------------+ +---------------+
+  | 512 bits      | | 512 bits      | | 512 bits      | ...
+  +---------------+ +---------------+ +---------------+
+                     ^ all K bits of key 12 are in here
+
+With 10 bits per key and K = 6, about 1% of the missing keys get a "maybe".
+
+Keys cannot be removed: a bit may be shared by several keys. The owner rebuilds
+the filter from scratch when too many of its keys are gone.
+
+*/
+
+class BloomFilter {
+ private:
+  static const int K = 6;
+  static const int BLOCK_BITS = 512;
+
+  struct alignas(64) Block {
+    uint64_t words[BLOCK_BITS / 64];
+  };
+
+  std::vector<Block> blocks;
+
+  // maps the high 32 bits of the hash onto 0 .. blocks - 1 with a multiply and
+  // a shift instead of a slower %, so any number of blocks works
+  size_t blockIndex(uint64_t hashVal) const {
+    return (size_t)(((hashVal >> 32) * blocks.size()) >> 32);
+  }
+
+ public:
+  // constructor
+  BloomFilter(int expectedKeys = 0, int bitsPerKey = 10) {
+    long long bits = (long long)expectedKeys * bitsPerKey;
+    blocks.assign((size_t)((bits + BLOCK_BITS - 1) / BLOCK_BITS) + 1, Block());
+  }
+
+  // hashVal is a good 64-bit hash of the key: the high half picks the block,
+  // a remix of it picks K bits (9 bits each) inside the block
+  void add(uint64_t hashVal) {
+    Block& block = blocks[blockIndex(hashVal)];
+    uint64_t bits = mix64(hashVal);
+    for (int i = 0; i < K; i++) {
+      int bit = (int)(bits & (BLOCK_BITS - 1));
+      block.words[bit / 64] |= 1ULL << (bit % 64);
+      bits >>= 9;
+    }
+  }
+
+  // false means the key was never added, true means it may have been
+  bool mayContain(uint64_t hashVal) const {
+    const Block& block = blocks[blockIndex(hashVal)];
+    uint64_t bits = mix64(hashVal);
+    for (int i = 0; i < K; i++) {
+      int bit = (int)(bits & (BLOCK_BITS - 1));
+      if (!(block.words[bit / 64] & (1ULL << (bit % 64)))) {
+        return false;
+      }
+      bits >>= 9;
+    }
+    return true;
+  }
+
+  size_t getBytes() const { return blocks.size() * sizeof(Block); }
+};
+
+#endif
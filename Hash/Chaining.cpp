@@ -1,13 +1,69 @@
 #include "Chaining.hpp"
 
-int Chaining::hash(int key) { return key % size; }
+// scramble the key with the seed
+uint64_t Chaining::keyHash(int key) const {
+  return hasher((uint64_t)key);
+}
+
+// the bucket index, never negative
+int Chaining::hash(int key, int tableSize) const {
+  return (int)(keyHash(key) % tableSize);
+}
 
 int Chaining::getSize() const { return size; }
 
 int Chaining::getCount() const { return count; }
 
-Chaining::Chaining(int tableSize)
-    : size(tableSize), count(0), table(tableSize, nullptr) {}
+bool Chaining::isRehashing() const { return oldSize > 0; }
+
+long long Chaining::getNodeAllocations() const {
+  return pool.getAllocations();
+}
+
+int Chaining::getSlabCount() const { return pool.getSlabCount(); }
+
+// the memory of the bucket arrays, the node slabs and the filter
+size_t Chaining::getBytes() const {
+  return (table.capacity() + oldTable.capacity()) * sizeof(Bucket) +
+         pool.getBytes() + (filterOn ? filter.getBytes() : 0);
+}
+
+// the most nodes in one bucket (a chain or a tree)
+int Chaining::getLongestChain() const {
+  int longest = 0;
+  for (int i = 0; i < size; i++) {
+    longest = table[i].length > longest ? table[i].length : longest;
+  }
+  for (int i = rehashIndex; i < oldSize; i++) {
+    longest = oldTable[i].length > longest ? oldTable[i].length : longest;
+  }
+  return longest;
+}
+
+// number of buckets that are trees right now
+int Chaining::getTreeCount() const {
+  int trees = 0;
+  for (int i = 0; i < size; i++) {
+    trees += table[i].isTree;
+  }
+  for (int i = rehashIndex; i < oldSize; i++) {
+    trees += oldTable[i].isTree;
+  }
+  return trees;
+}
+
+Chaining::Chaining(int tableSize, int step, double maxLoad, uint64_t seed)
+    : size(tableSize),
+      count(0),
+      rehashStep(step),
+      hasher(seed),
+      maxLoadFactor(maxLoad),
+      table(tableSize),
+      oldSize(0),
+      rehashIndex(0),
+      filterOn(false),
+      filterCapacity(0),
+      filterRemoves(0) {}
 /*
 if tableSize = 2
 
@@ -23,20 +79,37 @@ Two-bucket chaining hashtable is created...
 */
 
 Chaining::~Chaining() {
+  // the node memory goes back to the system slab by slab when the pool is
+  // destroyed, but every std::string value still owns memory of its own, so we
+  // visit the nodes to run their destructors
   for (int i = 0; i < size; i++) {
     // access to each node in the menu
-    Node* curr = table[i];
-    // clear the linked list
-    while (curr) {
-      Node* temp = curr;
-      curr = curr->next;
-      delete temp;
-    }
+    destroyBucket(table[i]);
+  }
+  // the buckets that have not been moved yet during a rehash
+  for (int i = rehashIndex; i < oldSize; i++) {
+    destroyBucket(oldTable[i]);
+  }
+}
+
+void Chaining::destroyBucket(Bucket& b) {
+  // a tree is turned into a chain first, so there is only one way to walk it
+  if (b.isTree) {
+    untreeify(b);
   }
+  // clear the linked list
+  Node* curr = b.head;
+  while (curr) {
+    Node* temp = curr;
+    curr = curr->next;
+    temp->~Node();
+  }
+  b = Bucket();
 }
 /*
-It is a linked-list hashtable. To prevent memory leak, we have to free the node
-one by one.
+It is a linked-list hashtable. To prevent memory leak, we have to destroy the
+values one by one. The nodes themselves live in the pool's slabs (Check the
+NodePool.hpp), which are freed all at once.
 
   +=====+ +-----+------+
 > |  0  |-|  1  + Alan |
@@ -75,43 +148,237 @@ one by one.
 
 */
 
-bool Chaining::add(int key, std::string val) {
-  Node* newNode = new Node(key, val);
+// returns the bucket that holds (or would hold) the key with this keyHash
+Chaining::Bucket& Chaining::bucket(uint64_t hashVal) {
+  if (isRehashing()) {
+    int oldIndex = (int)(hashVal % oldSize);
+    // this bucket has not been moved yet
+    if (oldIndex >= rehashIndex) {
+      return oldTable[oldIndex];
+    }
+  }
+  return table[hashVal % size];
+}
+
+// links an existing node into a sorted chain
+void Chaining::insertSorted(Node*& head, Node* node) {
+  Node* curr = head;
+  Node* prev = nullptr;
+  while (curr && node->key >= curr->key) {
+    prev = curr;
+    curr = curr->next;
+  }
+  if (prev) {
+    prev->next = node;
+  } else {
+    head = node;
+  }
+  node->next = curr;
+}
 
-  // use modulo to find the correct index
-  int index = hash(key);
+// links an existing node into a bucket, a chain that gets too long becomes a
+// tree
+void Chaining::insertNode(Bucket& b, Node* node) {
+  if (b.isTree) {
+    b.head = treeInsert(b.head, node);
+  } else {
+    insertSorted(b.head, node);
+  }
+  b.length++;
 
-  if (table[index]) {  // if the bucket is not empty
-    Node* curr = table[index];
-    Node* prev = nullptr;
+  if (!b.isTree && b.length > TREEIFY_THRESHOLD) {
+    treeify(b);
+  }
+}
 
-    // iterate to the end of the linked list
-    while (curr && key >= curr->key) {
-      // if find the node with the same data, replace it with the new data and
-      // then return false
-      if (curr->key == key) {
-        curr->val = val;
-        delete newNode;
-        return false;
-      }
-      // if not, move to the next node
-      prev = curr;
-      curr = curr->next;
+// returns the node of the key, or nullptr
+Chaining::Node* Chaining::findInBucket(const Bucket& b, int key) const {
+  Node* curr = b.head;
+  if (b.isTree) {
+    // go left or right, like any binary search tree
+    while (curr && curr->key != key) {
+      HASH_STATS_COUNT(probes++);
+      curr = key < curr->key ? curr->left : curr->right;
     }
-    if (prev) {
-      prev->next = newNode;
-    } else {
-      table[index] = newNode;
+    HASH_STATS_COUNT(probes += curr != nullptr);
+    return curr;
+  }
+
+  // iterate the linked list
+  while (curr) {
+    HASH_STATS_COUNT(probes++);
+    if (curr->key == key) {
+      return curr;
     }
-    newNode->next = curr;
-    count++;
-    return true;
-  } else {  // if the bucket is empty
-    // assign the new node to it
-    table[index] = newNode;
+    curr = curr->next;
+  }
+  return nullptr;
+}
+
+void Chaining::startRehash(int newSize) {
+  HASH_STATS_COUNT(resizes++);
+  // a rehash that is still running has to finish first
+  rehashBuckets(oldSize);
+
+  oldTable.swap(table);
+  oldSize = size;
+  rehashIndex = 0;
+
+  table.assign(newSize, Bucket());
+  size = newSize;
+
+  if (rehashStep == REHASH_ALL) {
+    rehashBuckets(oldSize);
+  }
+}
+
+// moves up to n buckets from the old table to the new one
+void Chaining::rehashBuckets(int n) {
+  if (!isRehashing()) {
+    return;
+  }
+
+  while (n > 0 && rehashIndex < oldSize) {
+    // move the nodes themselves, no node is created or deleted (a tree is
+    // turned into a chain first, its nodes are spread over two buckets anyway)
+    Bucket& old = oldTable[rehashIndex];
+    if (old.isTree) {
+      untreeify(old);
+    }
+    Node* curr = old.head;
+    while (curr) {
+      Node* next = curr->next;
+      insertNode(table[hash(curr->key, size)], curr);
+      curr = next;
+    }
+    old = Bucket();
+    rehashIndex++;
+    n--;
+  }
+
+  // every bucket has been moved, drop the old array
+  if (rehashIndex == oldSize) {
+    std::vector<Bucket>().swap(oldTable);
+    oldSize = 0;
+    rehashIndex = 0;
+  }
+}
+/*
+
+Adding 4 to a 2-bucket table that holds 1 and 11 (maxLoadFactor = 1.0,
+rehashStep = 1). Now 3 nodes > 1.0 * 2 buckets, so a 4-bucket table is created:
+
+  old table          new table
+  +=====+            +=====+
+  |  0  |-4          |  0  |-(Empty)
+  +=====+            +=====+
+  +=====+            +=====+
+  |  1  |-1-11       |  1  |-(Empty)
+  +=====+            +=====+
+                     +=====+
+                     |  2  |-(Empty)
+                     +=====+
+                     +=====+
+                     |  3  |-(Empty)
+                     +=====+
+
+Each of the next operations moves one old bucket. After two operations, the
+old table is empty and gets dropped:
+
+  +=====+
+  |  0  |-4
+  +=====+
+  +=====+
+  |  1  |-1
+  +=====+
+  +=====+
+  |  2  |-(Empty)
+  +=====+
+  +=====+
+  |  3  |-11
+  +=====+
+
+*/
+
+bool Chaining::add(int key, std::string val) {
+  // help the rehash along before touching the table
+  rehashBuckets(rehashStep);
+
+  // find the correct bucket
+  uint64_t hashVal = keyHash(key);
+  HASH_STATS_COUNT(probes = 0);
+  // val is our own copy, so it can be moved into the node
+  bool added = addToBucket(bucket(hashVal), key, std::move(val));
+  HASH_STATS_COUNT(addProbes.record(probes));
+  if (added) {
+    keyAdded(hashVal);
+  }
+  return added;
+}
+
+// the bookkeeping after a new key: the filter, and growing the table
+void Chaining::keyAdded(uint64_t hashVal) {
+  if (filterOn) {
+    filter.add(hashVal);
+    // the filter was sized for fewer keys, its false positives go up
+    if (count > filterCapacity) {
+      rebuildFilter();
+    }
+  }
+
+  // too many nodes per bucket, start moving them into a table twice as big
+  if (count > maxLoadFactor * size) {
+    startRehash(size * 2);
+  }
+}
+
+// links a new node into the bucket, or replaces the value of the key. val is
+// copied or moved, whichever the caller passed
+template <typename Value>
+bool Chaining::addToBucket(Bucket& b, int key, Value&& val) {
+  if (b.isTree) {
+    Node* found = findInBucket(b, key);
+    if (found) {
+      found->val = std::forward<Value>(val);
+      return false;
+    }
+    insertNode(b, pool.allocate(key, std::forward<Value>(val)));
     count++;
     return true;
   }
+
+  Node* curr = b.head;
+  Node* prev = nullptr;
+
+  // iterate to the end of the linked list (an empty bucket skips the loop)
+  while (curr && key >= curr->key) {
+    HASH_STATS_COUNT(probes++);
+    // if find the node with the same data, replace it with the new data and
+    // then return false
+    if (curr->key == key) {
+      curr->val = std::forward<Value>(val);
+      return false;
+    }
+    // if not, move to the next node
+    prev = curr;
+    curr = curr->next;
+  }
+
+  // only now take a node from the pool, so a duplicate key costs nothing
+  Node* newNode = pool.allocate(key, std::forward<Value>(val));
+  if (prev) {
+    prev->next = newNode;
+  } else {
+    b.head = newNode;
+  }
+  newNode->next = curr;
+  count++;
+  b.length++;
+
+  if (b.length > TREEIFY_THRESHOLD) {
+    treeify(b);
+  }
+  return true;
 }
 /*
 
@@ -167,46 +434,100 @@ Old value is replaced...
 
 */
 
-std::string Chaining::remove(int key) {
-  // use modulo to find the correct index
-  int index = hash(key);
+// takes the node of the key out of its bucket, or returns nullptr. The caller
+// gives the node back to the pool
+Chaining::Node* Chaining::detach(int key) {
+  rehashBuckets(rehashStep);
+
+  uint64_t hashVal = keyHash(key);
+  HASH_STATS_COUNT(probes = 0);
+  // the filter has never seen the key, no need to look for it
+  if (filterOn && !filter.mayContain(hashVal)) {
+    HASH_STATS_COUNT(filterRejects++);
+    HASH_STATS_COUNT(removeProbes.record(probes));
+    return nullptr;
+  }
 
   // access to the correct bucket
-  Node* curr = table[index];
-  Node* prev = nullptr;  // for keeping the linked list structure
-  while (curr && key >= curr->key) {
-    // if found the data
-    if (curr->key == key) {
-      // store the data value (we will return it later)
-      std::string deletedData = curr->val;
-      // first, skip the current data
-      if (prev) {
-        // if prev is not nullptr, connect the previous node's next to the
-        // current node's next
-        prev->next = curr->next;
-      } else {
-        // else, which means the data is in the first node, assign the current
-        // node's next to the bucket
-        table[index] = curr->next;
-      }
-      // store the node to be deleted
-      Node* temp = curr;
+  Bucket& b = bucket(hashVal);
+  Node* removed = nullptr;
 
-      // move curr to the next node
+  if (b.isTree) {
+    // treeRemove takes the same path as a search, count that path
+    HASH_STATS_COUNT(findInBucket(b, key));
+    b.head = treeRemove(b.head, key, removed);
+  } else {
+    Node* curr = b.head;
+    Node* prev = nullptr;  // for keeping the linked list structure
+    while (curr && key >= curr->key) {
+      HASH_STATS_COUNT(probes++);
+      // if found the data
+      if (curr->key == key) {
+        // skip the current node
+        if (prev) {
+          // if prev is not nullptr, connect the previous node's next to the
+          // current node's next
+          prev->next = curr->next;
+        } else {
+          // else, which means the data is in the first node, assign the
+          // current node's next to the bucket
+          b.head = curr->next;
+        }
+        removed = curr;
+        break;
+      }
+      prev = curr;
       curr = curr->next;
+    }
+  }
+  HASH_STATS_COUNT(removeProbes.record(probes));
 
-      // delete the node
-      delete temp;
-      count--;
+  // after iterating to the end, if nothing found, return nullptr
+  if (!removed) {
+    return nullptr;
+  }
 
-      return deletedData + " is removed";
-    }
-    prev = curr;
-    curr = curr->next;
+  count--;
+  b.length--;
+  // small enough to be a chain again
+  if (b.isTree && b.length <= UNTREEIFY_THRESHOLD) {
+    untreeify(b);
   }
+  filterRemoved();
+  return removed;
+}
 
-  // after iterating to the end, if nothing found, return false
-  return "No data found";
+std::string Chaining::remove(int key) {
+  Node* removed = detach(key);
+  if (!removed) {
+    return "No data found";
+  }
+
+  // the value is not needed in the node anymore, move it out
+  std::string deletedData = std::move(removed->val);
+  // give the node back to the pool
+  pool.release(removed);
+  return deletedData + " is removed";
+}
+
+bool Chaining::erase(int key) {
+  Node* removed = detach(key);
+  if (!removed) {
+    return false;
+  }
+  pool.release(removed);
+  return true;
+}
+
+// removes the key and moves its value into val
+bool Chaining::erase(int key, std::string& val) {
+  Node* removed = detach(key);
+  if (!removed) {
+    return false;
+  }
+  val = std::move(removed->val);
+  pool.release(removed);
+  return true;
 }
 /*
 
@@ -250,16 +571,32 @@ Return "No data found"
 
 */
 
+// returns the value of the key, or nullptr. The pointer stays valid until the
+// key is removed
+std::string* Chaining::find(int key) {
+  rehashBuckets(rehashStep);
+
+  uint64_t hashVal = keyHash(key);
+  HASH_STATS_COUNT(probes = 0);
+  // most missing keys stop here, after one look at the filter
+  if (filterOn && !filter.mayContain(hashVal)) {
+    HASH_STATS_COUNT(filterRejects++);
+    HASH_STATS_COUNT(searchProbes.record(probes));
+    return nullptr;
+  }
+
+  // walks the chain, or goes down the tree
+  Node* found = findInBucket(bucket(hashVal), key);
+  HASH_STATS_COUNT(searchProbes.record(probes));
+  HASH_STATS_COUNT(filterFalsePositives += filterOn && !found);
+  return found ? &found->val : nullptr;
+}
+
 std::string Chaining::search(int key) {
-  int index = hash(key);
-  Node* curr = table[index];
-  // iterate the linked list
-  while (curr) {
-    // if find the data, return true
-    if (curr->key == key) {
-      return curr->val + " is found";
-    }
-    curr = curr->next;
+  std::string* found = find(key);
+  // if find the data, return true
+  if (found) {
+    return *found + " is found";
   }
 
   // after iterating to the end, if nothing found, return false
@@ -296,18 +633,484 @@ Return "No data found"
 
 */
 
+// makes sure that n more keys fit without going above maxLoadFactor
+void Chaining::reserve(int n) {
+  while (count + n > maxLoadFactor * size) {
+    startRehash(size * 2);
+  }
+}
+
+// looks up n keys, results[i] points to the value of keys[i] or is nullptr (a
+// pointer stays valid until the table is changed)
+void Chaining::searchBatch(const int* keys, int n,
+                           const std::string** results) {
+  Bucket* heads[BATCH_SIZE];
+
+  for (int start = 0; start < n; start += BATCH_SIZE) {
+    int end = start + BATCH_SIZE < n ? start + BATCH_SIZE : n;
+
+    // the rehash work of the whole group, done before any bucket is picked
+    rehashBuckets(rehashStep * (end - start));
+
+    // 1. hash every key and start loading its bucket (a key the filter rules
+    // out gets no bucket at all)
+    for (int i = start; i < end; i++) {
+      uint64_t hashVal = keyHash(keys[i]);
+      if (filterOn && !filter.mayContain(hashVal)) {
+        HASH_STATS_COUNT(filterRejects++);
+        heads[i - start] = nullptr;
+        continue;
+      }
+      heads[i - start] = &bucket(hashVal);
+      prefetch(heads[i - start]);
+    }
+
+    // 2. the buckets have arrived, start loading the first node of each chain
+    // (or the root of each tree)
+    for (int i = start; i < end; i++) {
+      if (heads[i - start]) {
+        prefetch(heads[i - start]->head);
+      }
+    }
+
+    // 3. walk the chains
+    for (int i = start; i < end; i++) {
+      HASH_STATS_COUNT(probes = 0);
+      Node* found = heads[i - start]
+                        ? findInBucket(*heads[i - start], keys[i])
+                        : nullptr;
+      HASH_STATS_COUNT(searchProbes.record(probes));
+      results[i] = found ? &found->val : nullptr;
+    }
+  }
+}
+
+// adds n key-value pairs, returns how many keys were not in the table yet
+int Chaining::addBatch(const int* keys, const std::string* vals, int n) {
+  Bucket* heads[BATCH_SIZE];
+  uint64_t hashVals[BATCH_SIZE];
+  int added = 0;
+
+  for (int start = 0; start < n; start += BATCH_SIZE) {
+    int end = start + BATCH_SIZE < n ? start + BATCH_SIZE : n;
+
+    rehashBuckets(rehashStep * (end - start));
+    // grow once for the whole group, so no bucket moves while we use it
+    reserve(end - start);
+
+    for (int i = start; i < end; i++) {
+      hashVals[i - start] = keyHash(keys[i]);
+      heads[i - start] = &bucket(hashVals[i - start]);
+      prefetch(heads[i - start]);
+    }
+
+    for (int i = start; i < end; i++) {
+      prefetch(heads[i - start]->head);
+    }
+
+    for (int i = start; i < end; i++) {
+      HASH_STATS_COUNT(probes = 0);
+      if (addToBucket(*heads[i - start], keys[i], vals[i])) {
+        added++;
+        if (filterOn) {
+          filter.add(hashVals[i - start]);
+        }
+      }
+      HASH_STATS_COUNT(addProbes.record(probes));
+    }
+
+    if (filterOn && count > filterCapacity) {
+      rebuildFilter();
+    }
+  }
+
+  return added;
+}
+/*
+
+searchBatch of 1, 6 and 4 with BATCH_SIZE = 4:
+
+  step 1: hash 1 -> bucket 1, 6 -> bucket 1, 4 -> bucket 4, prefetch the three
+          bucket slots
+  step 2: prefetch node 1 (head of bucket 1) and node 4 (head of bucket 4)
+  step 3: walk the chains, the first nodes are already in the cache
+
++=====+ +-----+------+ +-----+-------+ +------+------+
+|  1  |-|  1  + Andy |-|  6  + Mandy |-|  11  + Judy |
++=====+ +-----+------+ +-----+-------+ +------+------+
+           ^ prefetched
++=====+ +-----+------+
+|  4  |-|  4  + Lulu |
++=====+ +-----+------+
+           ^ prefetched
+
+Without batching, each search waits for its bucket and then for its first node.
+With batching, the waits of the whole group overlap. Nodes further down a chain
+are not prefetched, so short chains (a low load factor) gain the most.
+
+*/
+
+void Chaining::enableFilter() {
+  filterOn = true;
+  rebuildFilter();
+}
+
+// a fresh filter with room for twice the current keys, so it is rebuilt again
+// only after the table has doubled
+void Chaining::rebuildFilter() {
+  filterCapacity = count * 2 > MIN_FILTER_KEYS ? count * 2 : MIN_FILTER_KEYS;
+  filterRemoves = 0;
+  filter = BloomFilter(filterCapacity, FILTER_BITS_PER_KEY);
+
+  for (int i = 0; i < size; i++) {
+    fillFilter(table[i].head, table[i].isTree);
+  }
+  for (int i = rehashIndex; i < oldSize; i++) {
+    fillFilter(oldTable[i].head, oldTable[i].isTree);
+  }
+}
+
+// adds every key of a chain (or a tree) to the filter
+void Chaining::fillFilter(Node* node, bool isTree) {
+  while (node) {
+    filter.add(keyHash(node->key));
+    if (isTree) {
+      fillFilter(node->left, true);
+      node = node->right;
+    } else {
+      node = node->next;
+    }
+  }
+}
+
+// a removed key stays in the filter and keeps answering "maybe", so after
+// many removes the filter is rebuilt from the keys that are left
+void Chaining::filterRemoved() {
+  if (filterOn && ++filterRemoves > filterCapacity / 2) {
+    rebuildFilter();
+  }
+}
+/*
+
+Searching 7 with the filter on:
+
+  filter.mayContain(hash of 7) --> false, return "No data found"
+
+The bucket array and the chain are never touched. Searching 6:
+
+  filter.mayContain(hash of 6) --> true, walk the chain as usual
+
++=====+ +-----+------+ +-----+-------+ +------+------+
+|  1  |-|  1  + Andy |-|  6  + Mandy |-|  11  + Judy |
++=====+ +-----+------+ +-----+-------+ +------+------+
+                          ^
+                        found!
+
+*/
+
+// turns a sorted chain into a balanced tree
+void Chaining::treeify(Bucket& b) {
+  HASH_STATS_COUNT(treeifies++);
+  Node* list = b.head;
+  b.head = buildTree(list, b.length);
+  b.isTree = true;
+}
+
+// turns a tree back into a sorted chain
+void Chaining::untreeify(Bucket& b) {
+  HASH_STATS_COUNT(untreeifies++);
+  Node* head = nullptr;
+  Node** tail = &head;
+  flatten(b.head, tail);
+  *tail = nullptr;
+  b.head = head;
+  b.isTree = false;
+}
+
+// builds a tree out of the next n nodes of a sorted list: the middle node is
+// the root, the nodes before it form the left subtree, the nodes after it the
+// right one. No rotation is needed and it takes O(n)
+Chaining::Node* Chaining::buildTree(Node*& list, int n) {
+  if (n == 0) {
+    return nullptr;
+  }
+
+  Node* left = buildTree(list, n / 2);
+  Node* root = list;
+  list = list->next;
+
+  root->left = left;
+  root->right = buildTree(list, n - n / 2 - 1);
+  root->next = nullptr;
+  updateHeight(root);
+  return root;
+}
+/*
+
+The chain of bucket 3 has 9 nodes, one more than TREEIFY_THRESHOLD:
+
+  +=====+ +---+ +---+ +---+ +---+ +---+ +---+ +---+ +---+ +---+
+  |  3  |-| 1 |-| 4 |-| 7 |-| 9 |-| 12|-| 15|-| 20|-| 25|-| 31|
+  +=====+ +---+ +---+ +---+ +---+ +---+ +---+ +---+ +---+ +---+
+                                    ^
+                               middle node
+
+buildTree takes 4 nodes for the left subtree, then the middle node as the root,
+then 4 nodes for the right subtree:
+
+                 +----+
+                 | 12 |
+                 +----+
+               /        \
+          +----+        +----+
+          |  7 |        | 25 |
+          +----+        +----+
+         /     \       /     \
+      +---+  +---+  +---+  +---+
+      | 4 |  | 9 |  | 20|  | 31|
+      +---+  +---+  +---+  +---+
+      /             /
+   +---+         +---+
+   | 1 |         | 15|
+   +---+         +---+
+
+*/
+
+// appends the nodes of the tree to the list in order (smallest key first)
+void Chaining::flatten(Node* node, Node**& tail) {
+  if (!node) {
+    return;
+  }
+  flatten(node->left, tail);
+  *tail = node;
+  tail = &node->next;
+  flatten(node->right, tail);
+}
+
+int Chaining::getHeight(Node* node) { return node ? node->height : 0; }
+
+int Chaining::balanceFactor(Node* node) {
+  return getHeight(node->left) - getHeight(node->right);
+}
+
+void Chaining::updateHeight(Node* node) {
+  int leftHeight = getHeight(node->left);
+  int rightHeight = getHeight(node->right);
+  node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+}
+
+Chaining::Node* Chaining::rotateLeft(Node* x) {
+  Node* y = x->right;
+  Node* T2 = y->left;
+
+  x->right = T2;
+  y->left = x;
+
+  updateHeight(x);
+  updateHeight(y);
+
+  return y;
+}
+
+Chaining::Node* Chaining::rotateRight(Node* y) {
+  Node* x = y->left;
+  Node* T2 = x->right;
+
+  x->right = y;
+  y->left = T2;
+
+  updateHeight(y);
+  updateHeight(x);
+
+  return x;
+}
+
+Chaining::Node* Chaining::balance(Node* node) {
+  updateHeight(node);
+
+  int bf = balanceFactor(node);
+
+  // left heavy
+  if (bf > 1) {
+    // Left Right case: the left child leans right, rotate it first
+    if (balanceFactor(node->left) < 0) {
+      node->left = rotateLeft(node->left);
+    }
+    return rotateRight(node);
+  }
+  // right heavy
+  if (bf < -1) {
+    // Right Left case: the right child leans left, rotate it first
+    if (balanceFactor(node->right) > 0) {
+      node->right = rotateRight(node->right);
+    }
+    return rotateLeft(node);
+  }
+
+  return node;
+}
+/*
+
+AVLtree.cpp checks "bf > 1" before "bf > 1 && balanceFactor(node->left) < 0",
+so its Left Right and Right Left cases can never run. Here the double rotation
+is checked inside the single rotation case instead.
+
+Left Right case, after adding 6 under 4:
+
+        +---+                 +---+
+        | 8 |                 | 8 |                 +---+
+        +---+                 +---+                 | 6 |
+        /          rotate     /          rotate     +---+
+    +---+          left   +---+          right      /   \
+    | 4 |          --->   | 6 |          --->   +---+   +---+
+    +---+          (4)    +---+          (8)    | 4 |   | 8 |
+        \                 /                     +---+   +---+
+        +---+          +---+
+        | 6 |          | 4 |
+        +---+          +---+
+
+A single right rotation at 8 would only move the problem to the other side.
+
+*/
+
+// adds an existing node (its key is not in the tree yet), returns the new root
+Chaining::Node* Chaining::treeInsert(Node* node, Node* newNode) {
+  if (!node) {
+    newNode->left = nullptr;
+    newNode->right = nullptr;
+    newNode->next = nullptr;
+    newNode->height = 1;
+    return newNode;
+  }
+
+  if (newNode->key < node->key) {
+    node->left = treeInsert(node->left, newNode);
+  } else {
+    node->right = treeInsert(node->right, newNode);
+  }
+
+  return balance(node);
+}
+
+// unlinks the node of the key (it is handed back in removed), returns the new
+// root
+Chaining::Node* Chaining::treeRemove(Node* node, int key, Node*& removed) {
+  if (!node) {
+    return nullptr;
+  }
+
+  if (key < node->key) {
+    node->left = treeRemove(node->left, key, removed);
+  } else if (key > node->key) {
+    node->right = treeRemove(node->right, key, removed);
+  } else {
+    removed = node;
+    // node with only one child or no child
+    if (!node->left) {
+      return node->right;
+    }
+    if (!node->right) {
+      return node->left;
+    }
+    // node with two children: the smallest node of the right subtree takes
+    // its place (the nodes are relinked, not copied, so pointers to the other
+    // values stay valid)
+    Node* successor = nullptr;
+    Node* right = removeMin(node->right, successor);
+    successor->left = node->left;
+    successor->right = right;
+    node = successor;
+  }
+
+  return balance(node);
+}
+
+// unlinks the smallest node of the subtree, returns the new root
+Chaining::Node* Chaining::removeMin(Node* node, Node*& min) {
+  if (!node->left) {
+    min = node;
+    return node->right;
+  }
+  node->left = removeMin(node->left, min);
+  return balance(node);
+}
+
+void Chaining::printTree(Node* node) {
+  if (!node) {
+    return;
+  }
+  printTree(node->left);
+  cout << node->key << "-" << node->val << " ";
+  printTree(node->right);
+}
+
 void Chaining::printChaining() const {
   for (int i = 0; i < size; i++) {
-    if (table[i]) {
-      cout << "[" << i << "]: ";
-      Node* curr = table[i];
+    cout << "[" << i << "]: ";
+    if (table[i].isTree) {
+      cout << "(tree) ";
+      printTree(table[i].head);
+    } else if (table[i].head) {
+      Node* curr = table[i].head;
       while (curr) {
         cout << curr->key << "-" << curr->val << " ";
         curr = curr->next;
       }
     } else {
-      cout << "[" << i << "]: (Empty)";
+      cout << "(Empty)";
     }
     cout << "\n";
   }
-}
\ No newline at end of file
+  // the buckets that are still waiting to be moved
+  for (int i = rehashIndex; i < oldSize; i++) {
+    if (oldTable[i].isTree) {
+      cout << "[old " << i << "]: (tree) ";
+      printTree(oldTable[i].head);
+      cout << "\n";
+    } else if (oldTable[i].head) {
+      cout << "[old " << i << "]: ";
+      Node* curr = oldTable[i].head;
+      while (curr) {
+        cout << curr->key << "-" << curr->val << " ";
+        curr = curr->next;
+      }
+      cout << "\n";
+    }
+  }
+}
+
+void Chaining::printStats() const {
+  cout << "buckets " << size << ", keys " << count << ", tree buckets "
+       << getTreeCount() << (isRehashing() ? ", rehashing" : "") << "\n";
+  cout << std::fixed << std::setprecision(2) << "load factor "
+       << (double)count / size << "\n";
+
+  Histogram chains;
+  for (int i = 0; i < size; i++) {
+    chains.record(table[i].length);
+  }
+  for (int i = rehashIndex; i < oldSize; i++) {
+    chains.record(oldTable[i].length);
+  }
+  chains.print("chain length");
+
+  if (filterOn) {
+    cout << "bloom filter " << filter.getBytes() / 1024 << " KB for "
+         << filterCapacity << " keys, removes since the last rebuild "
+         << filterRemoves << "\n";
+  }
+
+#if defined(HASH_STATS)
+  cout << "resizes " << resizes << ", chain -> tree " << treeifies
+       << ", tree -> chain " << untreeifies << "\n";
+  if (filterOn) {
+    cout << "misses stopped by the filter " << filterRejects
+         << ", false positives " << filterFalsePositives << "\n";
+  }
+  addProbes.print("add probes");
+  searchProbes.print("search probes");
+  removeProbes.print("remove probes");
+#else
+  cout << "(compile with -DHASH_STATS for probe lengths and resize counts)\n";
+#endif
+}
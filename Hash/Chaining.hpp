@@ -1,9 +1,16 @@
-#ifndef HASH_TABLE
-#define HASH_TABLE
+#ifndef CHAINING
+#define CHAINING
 
 #include <iostream>  // preprocessor directive
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "BloomFilter.hpp"
+#include "HashFunctions.hpp"
+#include "HashStats.hpp"
+#include "NodePool.hpp"
+
 using std::cin;  // using declaration
 using std::cout;
 
@@ -78,26 +85,226 @@ pairs that hash to the same index.
 
 */
 
+/*
+
+Incremental Rehashing:
+When the load factor goes above maxLoadFactor, the table doubles its number of
+buckets. Moving every node at once would make that one add as slow as the whole
+table. Instead, the old bucket array is kept next to the new one, and every add,
+search and remove moves only a few buckets (rehashStep) from the old array to
+the new one.
+
+  +=====+                       +=====+
+  |  0  |-(moved)               |  0  |-...
+  +=====+                       +=====+
+  |  1  |-(moved)               |  1  |-...
+  +=====+                       +=====+
+  |  2  |-...  <-- rehashIndex  |  2  |-...
+  +=====+                       +=====+
+  |  3  |-...                   |  3  |-...
+  +=====+                       +=====+
+  old table                     |  4  |-...
+                                +=====+
+                                 ...
+                                new table
+
+A key whose old bucket is below rehashIndex has already been moved, so it lives
+in the new table. Otherwise it is still in the old table. Either way, every key
+has exactly one bucket to look at.
+
+A rehashStep of REHASH_ALL (0) moves every bucket at once instead.
+
+
+Seeded Hashing:
+With hash(key) = key % size, keys like 5, 10, 15, ... all go into bucket 0 of a
+5-bucket table. Anyone who can choose the keys can build one long chain. So the
+key is scrambled with SipHash and a random seed drawn by every table first
+(Check the HashFunctions.hpp):
+
+  hash(key) = sipHash13(key, seed) % size
+
+The worked examples in Chaining.cpp still use key % size so that the buckets are
+easy to follow.
+
+
+Batched Operations:
+searchBatch and addBatch take many keys at once. For every group of BATCH_SIZE
+keys, they first compute all the buckets and prefetch them, then prefetch the
+first node of every chain, and only then walk the chains. The cache misses of
+the group are waited for together instead of one after another.
+
+
+Treeified Buckets:
+A chain is walked node by node, so a bucket with n nodes costs O(n) per search.
+When a chain grows past TREEIFY_THRESHOLD (8) nodes, the bucket is turned into
+an AVL tree (Check the AVLtree.cpp in BinaryTree), and a search in it costs
+O(log n). When removes bring it down to UNTREEIFY_THRESHOLD (6) nodes, it turns
+back into a sorted chain. The gap between 8 and 6 keeps a bucket that hovers
+around the threshold from converting back and forth on every add and remove.
+
+  +=====+ +---+ +---+ +---+     +---+            +=====+      +---+
+  |  3  |-| 1 |-| 4 |-| 7 |-...-|31 |   ---->    |  3  |-tree | 12|
+  +=====+ +---+ +---+ +---+     +---+            +=====+      +---+
+          9 nodes, sorted                                    /     \
+                                                          +---+   +---+
+                                                          | 4 |   | 25|
+                                                          +---+   +---+
+                                                          ...       ...
+
+With a good hash function, a chain of 9 nodes almost never happens. The trees
+are a safety net for a bad hash function or a flood of colliding keys.
+
+
+Bloom Filter:
+A search for a missing key still has to walk the whole chain (or tree) to be
+sure. With enableFilter, a Bloom filter sits in front of the buckets (Check the
+BloomFilter.hpp). Every added key is put into the filter; a search or remove
+asks the filter first, and if it says "definitely not", the buckets are never
+touched. The filter is one small array, so it mostly stays in the cache.
+
+ * It is sized from count: room for twice the keys of the table, rebuilt once
+   the table holds more keys than that
+ * A removed key cannot be taken out of the filter, so after removes equal to
+   half the capacity, the filter is rebuilt from the keys that are left
+
+
+Values Without Copies:
+search and remove return a message ("Mandy is found"), a new string every
+time, and a value given to add used to be copied on its way into the node. For
+big values the copies cost more than the table itself, so there is a second
+set of operations that never copies a value:
+
+  add(6, name)                    the parameter is a copy of name, it is moved
+                                  into the node (pass std::move(name) to skip
+                                  that copy too)
+  emplace(6, 40, 'x')             builds the value from the arguments, like
+                                  std::string(40, 'x'), and adds it like add
+  try_emplace(6, 40, 'x')         the same, but if 6 is already there its value
+                                  stays, and the new value is never built;
+                                  returns the value of 6 and whether it is new
+  find(6)                         a pointer to the value, or nullptr
+  erase(6) / erase(6, out)        removes 6, moving its value into out
+
+A pointer from find or try_emplace stays valid until the key is removed: nodes
+never move, not even when the table grows.
+
+
+Statistics:
+printStats shows the load factor and how many buckets hold 0, 1, 2, ... nodes.
+Compiled with -DHASH_STATS, it also shows how many nodes every add, search and
+remove looked at, and how often the table resized or converted a bucket
+(Check the HashStats.hpp).
+
+*/
+
+const int REHASH_ALL = 0;
+
 class Chaining {
   struct Node {
     int key;
     std::string val;
-    Node* next;
+    Node* next;  // the next node of a chain
+
+    // the children and the height in a tree bucket
+    Node* left;
+    Node* right;
+    int height;
+
+    // constructor, the arguments after the key build the value in place
+    template <typename... Args>
+    Node(int k, Args&&... args)
+        : key(k),
+          val(std::forward<Args>(args)...),
+          next(nullptr),
+          left(nullptr),
+          right(nullptr),
+          height(1) {}
+  };
+
+  struct Bucket {
+    Node* head;  // the first node of the chain, or the root of the tree
+    int length;  // number of nodes in the bucket
+    bool isTree;
 
     // constructor
-    Node(int k, std::string v) : key(k), val(v), next(nullptr) {}
+    Bucket() : head(nullptr), length(0), isTree(false) {}
   };
 
  private:
+  static constexpr int BATCH_SIZE = 16;
+  static constexpr int TREEIFY_THRESHOLD = 8;
+  static constexpr int UNTREEIFY_THRESHOLD = 6;
+  static constexpr int FILTER_BITS_PER_KEY = 10;
+  static constexpr int MIN_FILTER_KEYS = 64;
+
   int size;
   int count;
-  std::vector<Node*> table;
+  int rehashStep;
+  SeededHash hasher;  // SipHash with the secret key of this table
+  NodePool<Node> pool;  // every node of this table comes from here
+  double maxLoadFactor;
+  std::vector<Bucket> table;
+
+  // the old bucket array, only used while a rehash is in progress
+  int oldSize;
+  int rehashIndex;
+  std::vector<Bucket> oldTable;
+
+  // the optional Bloom filter in front of the buckets
+  bool filterOn;
+  int filterCapacity;  // number of keys the filter was sized for
+  int filterRemoves;   // removes since the filter was last rebuilt
+  BloomFilter filter;
 
-  int hash(int);
+#if defined(HASH_STATS)
+  mutable int probes = 0;  // nodes looked at by the current operation
+  Histogram addProbes;
+  Histogram searchProbes;
+  Histogram removeProbes;
+  int resizes = 0;
+  int treeifies = 0;
+  int untreeifies = 0;
+  int filterRejects = 0;  // misses answered by the filter alone
+  int filterFalsePositives = 0;
+#endif
+
+  uint64_t keyHash(int) const;
+  int hash(int, int) const;
+  Bucket& bucket(uint64_t);
+  void insertSorted(Node*&, Node*);
+  void insertNode(Bucket&, Node*);
+  template <typename Value>
+  bool addToBucket(Bucket&, int, Value&&);
+  void keyAdded(uint64_t);
+  Node* findInBucket(const Bucket&, int) const;
+  Node* detach(int);
+  void destroyBucket(Bucket&);
+  void startRehash(int);
+  void rehashBuckets(int);
+  void reserve(int);
+  void rebuildFilter();
+  void fillFilter(Node*, bool);
+  void filterRemoved();
+
+  // tree buckets, the rotations are the ones of AVLtree.cpp
+  void treeify(Bucket&);
+  void untreeify(Bucket&);
+  static Node* buildTree(Node*&, int);
+  static void flatten(Node*, Node**&);
+  static int getHeight(Node*);
+  static int balanceFactor(Node*);
+  static void updateHeight(Node*);
+  static Node* rotateLeft(Node*);
+  static Node* rotateRight(Node*);
+  static Node* balance(Node*);
+  static Node* treeInsert(Node*, Node*);
+  static Node* treeRemove(Node*, int, Node*&);
+  static Node* removeMin(Node*, Node*&);
+  static void printTree(Node*);
 
  public:
   // constructor
-  Chaining(int);
+  Chaining(int, int = 1, double = 1.0, uint64_t = randomSeed());
 
   // destructor
   ~Chaining();
@@ -106,9 +313,56 @@ class Chaining {
   std::string remove(int);
   std::string search(int);
 
+  // the same without copies of the value (Check Values Without Copies)
+  template <typename... Args>
+  bool emplace(int, Args&&...);
+  template <typename... Args>
+  std::pair<std::string*, bool> try_emplace(int, Args&&...);
+  std::string* find(int);
+  bool erase(int);
+  bool erase(int, std::string&);
+
+  void searchBatch(const int*, int, const std::string**);
+  int addBatch(const int*, const std::string*, int);
+  void enableFilter();
+
   int getSize() const;
   int getCount() const;
+  bool isRehashing() const;
+  long long getNodeAllocations() const;
+  int getSlabCount() const;
+  size_t getBytes() const;
+  int getLongestChain() const;
+  int getTreeCount() const;
   void printChaining() const;
+  void printStats() const;
 };
 
+template <typename... Args>
+bool Chaining::emplace(int key, Args&&... args) {
+  // the value is built right into add's parameter, and moved from there
+  return add(key, std::string(std::forward<Args>(args)...));
+}
+
+template <typename... Args>
+std::pair<std::string*, bool> Chaining::try_emplace(int key, Args&&... args) {
+  rehashBuckets(rehashStep);
+
+  uint64_t hashVal = keyHash(key);
+  HASH_STATS_COUNT(probes = 0);
+  Bucket& b = bucket(hashVal);
+  Node* found = findInBucket(b, key);
+  HASH_STATS_COUNT(addProbes.record(probes));
+  if (found) {
+    return std::pair<std::string*, bool>(&found->val, false);
+  }
+
+  // only a new key builds its value, right inside the node
+  Node* node = pool.allocate(key, std::forward<Args>(args)...);
+  insertNode(b, node);
+  count++;
+  keyAdded(hashVal);
+  return std::pair<std::string*, bool>(&node->val, true);
+}
+
 #endif
\ No newline at end of file
@@ -5,7 +5,9 @@ void printMenu();
 
 int main() {
   // declaration
-  Chaining chaining(5);
+  // a fixed seed gives the same buckets every run, leave it out to get a random
+  // one
+  Chaining chaining(5, 1, 1.0, 2024);
   int choice, key;
   std::string value, res;
   bool isRunning = true;
@@ -274,15 +276,15 @@ Enter a string: Lulu
 +=====+ +-----+------+ +-----+-------+ +------+------+
 |  1  |-|  1  + Andy |-|  6  + Mandy |-|  11  + Judy |
 +=====+ +-----+------+ +-----+-------+ +------+------+
++=====+ +-----+------+
+|  2  |-|  4  + Lulu |
++=====+ +-----+------+
 +=====+
-|  2  |-(Empty)
+|  3  |-(Empty)
 +=====+
 +=====+
-|  3  |-(Empty)
+|  4  |-(Empty)
 +=====+
-+=====+ +-----+------+
-|  4  |-|  4  + Lulu |
-+=====+ +-----+------+
 
 **** Menu ****
 | 1. Add     |
@@ -295,9 +297,9 @@ Enter a string: Lulu
 Enter your choice: 4
 [0]: (Empty)
 [1]: 1-Andy 6-Mandy 11-Judy
-[2]: (Empty)
+[2]: 4-Lulu
 [3]: (Empty)
-[4]: 4-Lulu
+[4]: (Empty)
 
 +=====+
 |  0  |-(Empty)
@@ -305,15 +307,15 @@ Enter your choice: 4
 +=====+ +-----+------+ +-----+-------+ +------+------+
 |  1  |-|  1  + Andy |-|  6  + Mandy |-|  11  + Judy |
 +=====+ +-----+------+ +-----+-------+ +------+------+
++=====+ +-----+------+
+|  2  |-|  4  + Lulu |
++=====+ +-----+------+
 +=====+
-|  2  |-(Empty)
+|  3  |-(Empty)
 +=====+
 +=====+
-|  3  |-(Empty)
+|  4  |-(Empty)
 +=====+
-+=====+ +-----+------+
-|  4  |-|  4  + Lulu |
-+=====+ +-----+------+
 
 **** Menu ****
 | 1. Add     |
@@ -334,15 +336,15 @@ Result: Mandy is found
 +=====+ +-----+------+ +-----+-------+ +------+------+
 |  1  |-|  1  + Andy |-|  6  + Mandy |-|  11  + Judy |
 +=====+ +-----+------+ +-----+-------+ +------+------+
-+=====+                          ^
-|  2  |-(Empty)
-+=====+
++=====+ +-----+------+           ^
+|  2  |-|  4  + Lulu |
++=====+ +-----+------+
 +=====+
 |  3  |-(Empty)
 +=====+
-+=====+ +-----+------+
-|  4  |-|  4  + Lulu |
-+=====+ +-----+------+
++=====+
+|  4  |-(Empty)
++=====+
 
 **** Menu ****
 | 1. Add     |
@@ -363,15 +365,15 @@ Result: No data found
 +=====+ +-----+------+ +-----+-------+ +------+------+
 |  1  |-|  1  + Andy |-|  6  + Mandy |-|  11  + Judy |
 +=====+ +-----+------+ +-----+-------+ +------+------+
-+=====+                               ^
-|  2  |-(Empty)                No data found!
-+=====+
++=====+ +-----+------+                ^
+|  2  |-|  4  + Lulu |         No data found!
++=====+ +-----+------+
 +=====+
 |  3  |-(Empty)
 +=====+
-+=====+ +-----+------+
-|  4  |-|  4  + Lulu |
-+=====+ +-----+------+
++=====+
+|  4  |-(Empty)
++=====+
 
 **** Menu ****
 | 1. Add     |
@@ -392,15 +394,15 @@ Result: No data found
 +=====+ +-----+------+ +-----+-------+ +------+------+
 |  1  |-|  1  + Andy |-|  6  + Mandy |-|  11  + Judy |
 +=====+ +-----+------+ +-----+-------+ +------+------+
-+=====+                               ^
-|  2  |-(Empty)                 No data found!
-+=====+
++=====+ +-----+------+                ^
+|  2  |-|  4  + Lulu |          No data found!
++=====+ +-----+------+
 +=====+
 |  3  |-(Empty)
 +=====+
-+=====+ +-----+------+
-|  4  |-|  4  + Lulu |
-+=====+ +-----+------+
++=====+
+|  4  |-(Empty)
++=====+
 
 **** Menu ****
 | 1. Add     |
@@ -421,15 +423,15 @@ Result: Mandy is removed
 +=====+ +-----+------+ +------+------+
 |  1  |-|  1  + Andy |-|  11  + Judy |
 +=====+ +-----+------+ +------+------+
++=====+ +-----+------+
+|  2  |-|  4  + Lulu |
++=====+ +-----+------+
 +=====+
-|  2  |-(Empty)
+|  3  |-(Empty)
 +=====+
 +=====+
-|  3  |-(Empty)
+|  4  |-(Empty)
 +=====+
-+=====+ +-----+------+
-|  4  |-|  4  + Lulu |
-+=====+ +-----+------+
 
 **** Menu ****
 | 1. Add     |
@@ -445,9 +447,9 @@ Exit the program...
 Final Chaining:
 [0]: (Empty)
 [1]: 1-Andy 11-Judy
-[2]: (Empty)
+[2]: 4-Lulu
 [3]: (Empty)
-[4]: 4-Lulu
+[4]: (Empty)
 
 +=====+
 |  0  |-(Empty)
@@ -455,14 +457,14 @@ Final Chaining:
 +=====+ +-----+------+ +------+------+
 |  1  |-|  1  + Andy |-|  11  + Judy |
 +=====+ +-----+------+ +------+------+
++=====+ +-----+------+
+|  2  |-|  4  + Lulu |
++=====+ +-----+------+
 +=====+
-|  2  |-(Empty)
+|  3  |-(Empty)
 +=====+
 +=====+
-|  3  |-(Empty)
+|  4  |-(Empty)
 +=====+
-+=====+ +-----+------+
-|  4  |-|  4  + Lulu |
-+=====+ +-----+------+
 
 */
\ No newline at end of file
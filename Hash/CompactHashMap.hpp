@@ -0,0 +1,286 @@
+#ifndef COMPACT_HASH_MAP
+#define COMPACT_HASH_MAP
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>  // preprocessor directive
+#include <utility>
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+CompactHashMap keeps its entries in one array, in the order they were
+inserted, and uses a separate array of small integers (the index) as the
+hash table. This is the layout of Python's dict.
+
+  insert 7 -> "a", 12 -> "b", 3 -> "c"
+
+  index (8 slots)                      entries
+  +----+----+----+----+----+----+----+----+    +---+--------+
+  | -1 |  1 | -1 | -1 |  0 | -1 |  2 | -1 |    | 0 | 7, a   |
+  +----+----+----+----+----+----+----+----+    | 1 | 12, b  |
+                                               | 2 | 3, c   |
+                                               +---+--------+
+  hash(12) lands on slot 1, which says "entry 1"; -1 is an empty slot
+
+ * A search hashes the key to a slot of the index and probes linearly, like
+   HashTable.cpp, but the slots only hold entry numbers
+ * The index is tiny: a slot is 1 byte while there are at most 127 entries,
+   2 bytes up to 32767 and 4 bytes above that. Even with empty slots it costs
+   a few bytes per entry
+ * The entries have no pointers and no empty gaps, so there is no node per
+   entry as in Chaining or HashMap, and walking them is a walk over one array
+ * Iterating goes over the entries array, so it always follows insertion
+   order: the same inserts give the same order, whatever the hash function
+
+Removing a key cannot shift the entries (every index slot after it would have
+to change), so the entry becomes a hole and its index slot is marked DELETED
+(-2), which searches walk past like the dirty slots of HashTable.cpp:
+
+  remove 12
+
+  index                                        entries
+  +----+----+----+----+----+----+----+----+    +---+--------+
+  | -1 | -2 | -1 | -1 |  0 | -1 |  2 | -1 |    | 0 | 7, a   |
+  +----+----+----+----+----+----+----+----+    | 1 | (hole) |
+                                               | 2 | 3, c   |
+                                               +---+--------+
+
+When the entries array is full (holes included), the map is rebuilt: the
+holes are squeezed out, the array gets room for half again as many entries as
+are live (so a map that lost many keys shrinks), and the index gets the
+fewest slots (a power of two) that keep it at most 2/3 full.
+
+ Time Complexity
+ +------------+----------+----------+
+ | Operation  | Worst*   | Average  |
+ +------------+----------+----------+
+ | Search     | O(n)     | O(1)     |
+ | Insertion  | O(n)     | O(1)     |
+ | Deletion   | O(n)     | O(1)     |
+ | Iteration  | O(n)     | O(n)     |
+ +------------+----------+----------+
+ * The worst case happens when the hash function sends many keys to one slot
+
+ Space complexity: O(n), the entries plus 1 to 4 bytes per index slot
+
+ Cons:
+ * A pointer from find is only valid until the next insert, because a
+   rebuild moves the entries
+ * Removed entries take space until the next rebuild
+
+*/
+
+template <typename K, typename V, typename Hash = Mix64Hash,
+          typename Eq = std::equal_to<K>>
+class CompactHashMap {
+ private:
+  static const int32_t EMPTY = -1;
+  static const int32_t DELETED = -2;
+  static const size_t MIN_SLOTS = 8;
+
+  struct Entry {
+    K key;
+    V val;
+
+    // constructor
+    Entry(const K& k, const V& v) : key(k), val(v) {}
+  };
+
+  std::vector<Entry> entries;         // insertion order, holes included
+  std::vector<bool> removed;          // removed[i] is set if entry i is a hole
+  std::vector<unsigned char> index;   // slots * width bytes
+  size_t capacity;                    // entries until the next rebuild
+  size_t slots;                       // always a power of two
+  int width;                          // bytes per slot: 1, 2 or 4
+  size_t count;                       // live entries
+  Hash hasher;
+  Eq equal;
+
+  int32_t slotAt(size_t i) const {
+    if (width == 1) {
+      return (int8_t)index[i];
+    }
+    if (width == 2) {
+      int16_t v;
+      std::memcpy(&v, &index[i * 2], 2);
+      return v;
+    }
+    int32_t v;
+    std::memcpy(&v, &index[i * 4], 4);
+    return v;
+  }
+
+  void setSlot(size_t i, int32_t v) {
+    if (width == 1) {
+      index[i] = (unsigned char)(int8_t)v;
+    } else if (width == 2) {
+      int16_t narrow = (int16_t)v;
+      std::memcpy(&index[i * 2], &narrow, 2);
+    } else {
+      std::memcpy(&index[i * 4], &v, 4);
+    }
+  }
+
+  // returns the index slot that refers to the key, or the empty slot where the
+  // key would go
+  size_t findSlot(const K& key) const {
+    size_t i = hasher(key) & (slots - 1);
+    while (true) {
+      int32_t e = slotAt(i);
+      if (e == EMPTY || (e >= 0 && equal(entries[e].key, key))) {
+        return i;
+      }
+      i = (i + 1) & (slots - 1);
+    }
+  }
+
+  // room for n entries and a new index, the holes are dropped
+  void rebuild(size_t n) {
+    capacity = n;
+    slots = MIN_SLOTS;
+    while (slots * 2 / 3 < capacity) {
+      slots *= 2;
+    }
+    // the biggest entry number must fit into a slot, -1 and -2 are taken
+    width = capacity <= INT8_MAX ? 1 : capacity <= INT16_MAX ? 2 : 4;
+
+    std::vector<Entry> live;
+    live.reserve(capacity);
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (!removed[i]) {
+        live.push_back(std::move(entries[i]));
+      }
+    }
+    entries.swap(live);
+    removed.assign(entries.size(), false);
+
+    // every byte 0xFF: -1 (EMPTY) in any width
+    index.assign(slots * width, 0xFF);
+    for (size_t i = 0; i < entries.size(); i++) {
+      setSlot(findSlot(entries[i].key), (int32_t)i);
+    }
+  }
+
+ public:
+  // constructor, room for the expected number of entries before the first
+  // rebuild
+  CompactHashMap(size_t expected = 0)
+      : capacity(0), slots(0), width(1), count(0) {
+    rebuild(expected > MIN_SLOTS ? expected : MIN_SLOTS);
+  }
+
+  // returns true if the key is new, false if the old value is replaced
+  bool insert(const K& key, const V& val) {
+    size_t slot = findSlot(key);
+    if (slotAt(slot) >= 0) {
+      entries[slotAt(slot)].val = val;
+      return false;
+    }
+
+    // the entries array is full (holes count too), make room first
+    if (entries.size() == capacity) {
+      rebuild(count + count / 2 + MIN_SLOTS);
+      slot = findSlot(key);
+    }
+
+    setSlot(slot, (int32_t)entries.size());
+    entries.emplace_back(key, val);
+    removed.push_back(false);
+    count++;
+    return true;
+  }
+
+  // returns the value of the key, or nullptr if the key is not in the map
+  V* find(const K& key) {
+    int32_t e = slotAt(findSlot(key));
+    return e >= 0 ? &entries[e].val : nullptr;
+  }
+
+  const V* find(const K& key) const {
+    int32_t e = slotAt(findSlot(key));
+    return e >= 0 ? &entries[e].val : nullptr;
+  }
+
+  bool contains(const K& key) const { return slotAt(findSlot(key)) >= 0; }
+
+  // returns the value of the key, adding a default value if it is missing
+  V& operator[](const K& key) {
+    V* val = find(key);
+    if (!val) {
+      insert(key, V());
+      val = find(key);
+    }
+    return *val;
+  }
+
+  bool remove(const K& key) {
+    size_t slot = findSlot(key);
+    int32_t e = slotAt(slot);
+    if (e < 0) {
+      return false;
+    }
+
+    setSlot(slot, DELETED);
+    removed[e] = true;
+    entries[e].val = V();  // let go of what the value owns
+    count--;
+    return true;
+  }
+
+  void clear() {
+    entries.clear();
+    removed.clear();
+    count = 0;
+    rebuild(MIN_SLOTS);
+  }
+
+  // calls f(key, value) for every entry, in insertion order
+  template <typename F>
+  void forEach(F f) const {
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (!removed[i]) {
+        f(entries[i].key, entries[i].val);
+      }
+    }
+  }
+
+  size_t size() const { return count; }
+
+  bool isEmpty() const { return count == 0; }
+
+  size_t slotCount() const { return slots; }
+
+  int indexWidth() const { return width; }
+
+  // the memory of the entries, the index and the hole flags
+  size_t getBytes() const {
+    return entries.capacity() * sizeof(Entry) + index.size() +
+           removed.capacity() / 8;
+  }
+
+  void printMap() const {
+    cout << "Index (" << slots << " slots, " << width << " byte"
+         << (width > 1 ? "s" : "") << " each):";
+    for (size_t i = 0; i < slots; i++) {
+      cout << " " << slotAt(i);
+    }
+    cout << "\nEntries:\n";
+    for (size_t i = 0; i < entries.size(); i++) {
+      cout << "  " << i << ": ";
+      if (removed[i]) {
+        cout << "(hole)\n";
+      } else {
+        cout << entries[i].key << "-" << entries[i].val << "\n";
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,70 @@
+#include <string>
+
+#include "CompactHashMap.hpp"
+
+int main() {
+  // declaration
+  CompactHashMap<std::string, int> stock;
+
+  stock.insert("pear", 4);
+  stock.insert("apple", 10);
+  stock.insert("fig", 7);
+  stock.insert("kiwi", 2);
+  stock["apple"] += 5;  // replaces the value, apple keeps its place
+  stock.remove("fig");
+  stock.insert("plum", 9);
+
+  cout << "Map:\n";
+  stock.printMap();
+
+  // always the insertion order, so writing the map out gives the same bytes
+  // every time
+  cout << "\nIn insertion order:";
+  stock.forEach([](const std::string& name, int n) {
+    cout << " " << name << "=" << n;
+  });
+  cout << "\n";
+
+  const int* kiwi = stock.find("kiwi");
+  cout << "\nkiwi: " << (kiwi ? std::to_string(*kiwi) : "not found") << "\n";
+  cout << "fig: " << (stock.contains("fig") ? "found" : "not found") << "\n";
+
+  // the slots of the index get wider only when the entries need it
+  CompactHashMap<int, int> squares;
+  int widths[] = {10, 200, 40000};
+  for (int n : widths) {
+    while ((int)squares.size() < n) {
+      int i = (int)squares.size();
+      squares.insert(i, i * i);
+    }
+    cout << "\n" << n << " entries: " << squares.slotCount() << " slots of "
+         << squares.indexWidth() << " byte(s), " << squares.getBytes()
+         << " bytes";
+  }
+  cout << "\n\n";
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+Map:
+Index (16 slots, 1 byte each): -1 -1 -1 -1 -1 -1 1 -2 0 3 -1 -1 -1 4 -1 -1
+Entries:
+  0: pear-4
+  1: apple-15
+  2: (hole)
+  3: kiwi-2
+  4: plum-9
+
+In insertion order: pear=4 apple=15 kiwi=2 plum=9
+
+kiwi: 2
+fig: not found
+
+10 entries: 32 slots of 1 byte(s), 200 bytes
+200 entries: 512 slots of 2 byte(s), 3096 bytes
+40000 entries: 131072 slots of 4 byte(s), 953128 bytes
+
+*/
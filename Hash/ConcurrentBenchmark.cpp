@@ -0,0 +1,116 @@
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+#include "Chaining.cpp"
+#include "ConcurrentChaining.cpp"
+
+/*
+
+A multi-threaded throughput benchmark: one Chaining table behind a single mutex
+vs ConcurrentChaining with striped reader-writer locks.
+
+Build it with optimizations and threads turned on, for example:
+
+  g++ -std=c++17 -O2 -pthread ConcurrentBenchmark.cpp -o ConcurrentBenchmark
+
+Each thread runs the same read-mostly mix on a shared table: 90% search, 5% add
+and 5% remove over 100000 keys. We report millions of operations per second.
+
+*/
+
+using Clock = std::chrono::steady_clock;
+
+const int KEYS = 100000;
+const int OPS_PER_THREAD = 1000000;
+
+// the whole table behind one lock, the way it is used today
+struct LockedChaining {
+  Chaining chaining;
+  std::mutex lock;
+
+  LockedChaining() : chaining(KEYS) {}
+
+  bool add(int key, const std::string& val) {
+    std::lock_guard<std::mutex> guard(lock);
+    return chaining.add(key, val);
+  }
+
+  bool remove(int key) {
+    std::lock_guard<std::mutex> guard(lock);
+    return chaining.remove(key) != "No data found";
+  }
+
+  bool search(int key, std::string& val) {
+    std::lock_guard<std::mutex> guard(lock);
+    val = chaining.search(key);
+    return val != "No data found";
+  }
+};
+
+template <typename Table>
+void worker(Table& table, int id, long long& found) {
+  // every thread has its own xorshift generator
+  unsigned long long state = 88172645463325252ULL + id;
+  std::string val;
+  long long hits = 0;
+
+  for (int i = 0; i < OPS_PER_THREAD; i++) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    int key = (int)(state % KEYS);
+    int op = (int)((state >> 32) % 100);
+
+    if (op < 90) {
+      hits += table.search(key, val);
+    } else if (op < 95) {
+      table.add(key, "value");
+    } else {
+      table.remove(key);
+    }
+  }
+  found = hits;
+}
+
+// returns millions of operations per second
+template <typename Table>
+double run(int threads) {
+  Table table;
+  for (int key = 0; key < KEYS; key += 2) {
+    table.add(key, "value");
+  }
+
+  std::vector<std::thread> pool;
+  std::vector<long long> found(threads);
+
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < threads; i++) {
+    pool.emplace_back(worker<Table>, std::ref(table), i, std::ref(found[i]));
+  }
+  for (std::thread& t : pool) {
+    t.join();
+  }
+  Clock::time_point end = Clock::now();
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  return (double)threads * OPS_PER_THREAD / seconds / 1e6;
+}
+
+int main() {
+  int cores = (int)std::thread::hardware_concurrency();
+  cout << "\n==== Read-mostly throughput (million ops/sec) ====\n";
+  cout << "hardware threads: " << cores << "\n\n";
+  cout << "  threads   one mutex   striped\n";
+
+  for (int threads = 1; threads <= 16; threads *= 2) {
+    double locked = run<LockedChaining>(threads);
+    double striped = run<ConcurrentChaining>(threads);
+    cout << std::fixed << std::setprecision(2) << std::setw(9) << threads
+         << std::setw(12) << locked << std::setw(10) << striped << "\n";
+  }
+  cout << "\n";
+
+  return 0;
+}
@@ -0,0 +1,161 @@
+#include "ConcurrentChaining.hpp"
+
+ConcurrentChaining::ConcurrentChaining(int tableSize, double maxLoad)
+    : maxLoadFactor(maxLoad), count(0) {
+  // a power of two, and at least one bucket per stripe
+  size_t size = STRIPES;
+  while (size < (size_t)tableSize) {
+    size *= 2;
+  }
+  table.assign(size, nullptr);
+}
+
+ConcurrentChaining::~ConcurrentChaining() {
+  for (Node* curr : table) {
+    while (curr) {
+      Node* temp = curr;
+      curr = curr->next;
+      delete temp;
+    }
+  }
+}
+
+// mix the key, so that both the stripes and the buckets are evenly used
+size_t ConcurrentChaining::hash(int key) const {
+  return (size_t)mix64((uint64_t)key);
+}
+
+int ConcurrentChaining::getSize() const {
+  std::shared_lock<std::shared_mutex> lock(locks[0]);
+  return (int)table.size();
+}
+
+int ConcurrentChaining::getCount() const { return count.load(); }
+
+bool ConcurrentChaining::add(int key, const std::string& val) {
+  size_t hashVal = hash(key);
+  bool added = false;
+  size_t size;
+
+  {
+    // only this stripe is locked, other threads keep working on the others
+    std::unique_lock<std::shared_mutex> lock(locks[hashVal % STRIPES]);
+    size = table.size();
+    Node*& head = table[hashVal & (size - 1)];
+
+    Node* curr = head;
+    while (curr && curr->key != key) {
+      curr = curr->next;
+    }
+
+    if (curr) {
+      // the key is already there, replace the old value
+      curr->val = val;
+    } else {
+      head = new Node(key, val, head);
+      added = true;
+    }
+  }
+
+  // resize after the stripe lock is released, resize takes every lock itself
+  if (added && count.fetch_add(1) + 1 > maxLoadFactor * size) {
+    resize(size * 2);
+  }
+  return added;
+}
+
+bool ConcurrentChaining::remove(int key) {
+  size_t hashVal = hash(key);
+  std::unique_lock<std::shared_mutex> lock(locks[hashVal % STRIPES]);
+
+  Node** link = &table[hashVal & (table.size() - 1)];
+  while (*link) {
+    if ((*link)->key == key) {
+      Node* temp = *link;
+      *link = temp->next;
+      delete temp;
+      count--;
+      return true;
+    }
+    link = &(*link)->next;
+  }
+  return false;
+}
+
+bool ConcurrentChaining::search(int key, std::string& val) const {
+  size_t hashVal = hash(key);
+  // a shared lock: other readers of this stripe are not blocked
+  std::shared_lock<std::shared_mutex> lock(locks[hashVal % STRIPES]);
+
+  Node* curr = table[hashVal & (table.size() - 1)];
+  while (curr) {
+    if (curr->key == key) {
+      val = curr->val;
+      return true;
+    }
+    curr = curr->next;
+  }
+  return false;
+}
+
+void ConcurrentChaining::resize(size_t newSize) {
+  // take every stripe lock, always from stripe 0 upward
+  std::vector<std::unique_lock<std::shared_mutex>> all;
+  for (int i = 0; i < STRIPES; i++) {
+    all.emplace_back(locks[i]);
+  }
+
+  // another thread may have resized while we were waiting for the locks
+  if (table.size() >= newSize) {
+    return;
+  }
+
+  std::vector<Node*> oldTable(newSize, nullptr);
+  oldTable.swap(table);
+
+  for (Node* curr : oldTable) {
+    while (curr) {
+      Node* next = curr->next;
+      Node*& head = table[hash(curr->key) & (newSize - 1)];
+      curr->next = head;
+      head = curr;
+      curr = next;
+    }
+  }
+}
+/*
+
+Thread A adds key 5 (stripe 1) while thread B searches key 6 (stripe 2):
+
+  stripe 1 lock: A (writer)      stripe 2 lock: B (reader)
+
+Neither waits for the other.
+
+Thread C searches key 9 (stripe 1) while A still holds it:
+
+  stripe 1 lock: A (writer), C waits
+
+Threads D and E both search keys of stripe 3:
+
+  stripe 3 lock: D (reader), E (reader), nobody waits
+
+*/
+
+void ConcurrentChaining::printChaining() const {
+  // printing needs a stable view of every bucket
+  std::vector<std::shared_lock<std::shared_mutex>> all;
+  for (int i = 0; i < STRIPES; i++) {
+    all.emplace_back(locks[i]);
+  }
+
+  for (size_t i = 0; i < table.size(); i++) {
+    cout << "[" << i << "]: ";
+    if (!table[i]) {
+      cout << "(Empty)";
+    }
+    for (Node* curr = table[i]; curr; curr = curr->next) {
+      cout << curr->key << "-" << curr->val << " ";
+    }
+    cout << "\n";
+  }
+}
@@ -0,0 +1,90 @@
+#ifndef CONCURRENT_CHAINING
+#define CONCURRENT_CHAINING
+
+#include <atomic>
+#include <iostream>  // preprocessor directive
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+ConcurrentChaining is a Chaining table (Check the Chaining.hpp) that many
+threads can use at the same time.
+
+The simple way is one mutex around the whole table. Then only one thread can
+touch the table at a time, even if two threads want different buckets.
+
+Lock Striping:
+Instead, the buckets are split into STRIPES groups, and every group has its own
+lock. Bucket i belongs to stripe i % STRIPES.
+
+  stripe 0 lock ---> buckets 0, 4, 8, 12, ...
+  stripe 1 lock ---> buckets 1, 5, 9, 13, ...
+  stripe 2 lock ---> buckets 2, 6, 10, 14, ...
+  stripe 3 lock ---> buckets 3, 7, 11, 15, ...
+  (STRIPES = 4 in this picture)
+
+Two threads only wait for each other if their keys fall into the same stripe.
+
+Readers and Writers:
+Each stripe lock is a reader-writer lock (std::shared_mutex). Any number of
+search calls can walk the chains of a stripe together; add and remove wait until
+they are alone in the stripe. On a read-mostly workload, readers almost never
+wait.
+
+Resizing:
+The number of buckets is always a multiple of STRIPES, so doubling it never
+moves a key to another stripe:
+
+  hash % 16 % 4 == hash % 32 % 4 == hash % 4
+
+To resize, a thread takes every stripe lock (always in the same order, so two
+resizing threads cannot deadlock), moves the nodes, and releases them.
+
+*/
+
+class ConcurrentChaining {
+  struct Node {
+    int key;
+    std::string val;
+    Node* next;
+
+    // constructor
+    Node(int k, const std::string& v, Node* n) : key(k), val(v), next(n) {}
+  };
+
+ private:
+  static constexpr int STRIPES = 64;
+
+  double maxLoadFactor;
+  std::vector<Node*> table;
+  std::atomic<int> count;
+  mutable std::shared_mutex locks[STRIPES];
+
+  size_t hash(int) const;
+  void resize(size_t);
+
+ public:
+  // constructor
+  ConcurrentChaining(int = STRIPES, double = 1.0);
+
+  // destructor
+  ~ConcurrentChaining();
+
+  bool add(int, const std::string&);
+  bool remove(int);
+  bool search(int, std::string&) const;
+
+  int getSize() const;
+  int getCount() const;
+  void printChaining() const;
+};
+
+#endif
@@ -0,0 +1,196 @@
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "Chaining.cpp"
+#include "ConsistentHashRing.cpp"
+
+using Clock = std::chrono::steady_clock;
+
+const int KEYS = 200000;
+
+// how the keys are split over the workers, before and after one more worker
+struct Moves {
+  int moved;
+  int busiest;  // keys of the busiest worker, after
+};
+
+template <typename Before, typename After>
+Moves countMoves(int workers, Before before, After after) {
+  std::vector<int> load(workers + 1, 0);
+  Moves res{0, 0};
+  for (int key = 0; key < KEYS; key++) {
+    int worker = after(key);
+    res.moved += before(key) != worker;
+    load[worker]++;
+  }
+  for (int keys : load) {
+    res.busiest = std::max(res.busiest, keys);
+  }
+  return res;
+}
+
+void printMoves(const std::string& name, const Moves& moves, int workers) {
+  double average = (double)KEYS / workers;
+  cout << "  " << std::left << std::setw(22) << name << std::right
+       << std::setw(8) << moves.moved << std::setw(8) << std::fixed
+       << std::setprecision(1) << moves.moved * 100.0 / KEYS << "%"
+       << std::setw(10) << std::setprecision(2) << moves.busiest / average
+       << "\n";
+}
+
+template <typename F>
+double nsPerLookup(F workerOf) {
+  volatile int sink = 0;
+  int sum = 0;
+  Clock::time_point start = Clock::now();
+  for (int pass = 0; pass < 10; pass++) {
+    for (int key = 0; key < KEYS; key++) {
+      sum += workerOf(key);
+    }
+  }
+  Clock::time_point end = Clock::now();
+  sink = sink + sum;
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         (10.0 * KEYS);
+}
+
+int main() {
+  const int WORKERS = 8;
+
+  // every worker thread owns one Chaining table and only adds its own keys,
+  // so no table is shared and nobody takes a lock
+  ConsistentHashRing ring(WORKERS);
+  std::vector<std::unique_ptr<Chaining>> shards;
+  for (int t = 0; t < WORKERS; t++) {
+    shards.emplace_back(new Chaining(1024));
+  }
+
+  std::vector<std::thread> pool;
+  for (int t = 0; t < WORKERS; t++) {
+    pool.emplace_back([&, t]() {
+      for (int key = 0; key < KEYS; key++) {
+        if (ring.workerFor(key) == t) {
+          shards[t]->add(key, "v" + std::to_string(key));
+        }
+      }
+    });
+  }
+  for (std::thread& worker : pool) {
+    worker.join();
+  }
+
+  cout << "\n" << KEYS << " keys on " << WORKERS << " workers, "
+       << ring.getVirtualNodes() << " tokens each:\n";
+  for (int t = 0; t < WORKERS; t++) {
+    cout << "  worker " << t << ": " << shards[t]->getCount() << " keys\n";
+  }
+
+  // a ninth worker joins: only the keys that now belong to it move
+  ring.addWorker(WORKERS);
+  shards.emplace_back(new Chaining(1024));
+  int moved = 0;
+  for (int key = 0; key < KEYS; key++) {
+    if (ring.workerFor(key) == WORKERS) {
+      for (int t = 0; t < WORKERS; t++) {
+        std::string val;
+        if (shards[t]->erase(key, val)) {
+          shards[WORKERS]->add(key, std::move(val));
+          moved++;
+        }
+      }
+    }
+  }
+  cout << "\nWorker " << WORKERS << " joins, " << moved
+       << " keys move to it, all from the other workers\n";
+  std::string* val = shards[ring.workerFor(4242)]->find(4242);
+  cout << "Key 4242 is on worker " << ring.workerFor(4242) << ": " << *val
+       << "\n";
+
+  // the same step, 8 --> 9 workers, with every way of sharding
+  cout << "\nFrom " << WORKERS << " to " << WORKERS + 1
+       << " workers (ideal: " << std::fixed << std::setprecision(1)
+       << 100.0 / (WORKERS + 1) << "% move)\n\n";
+  cout << "                           moved        busiest / average\n";
+
+  printMoves("key % workers",
+             countMoves(WORKERS, [](int key) { return key % WORKERS; },
+                        [](int key) { return key % (WORKERS + 1); }),
+             WORKERS + 1);
+
+  const int tokenCounts[] = {1, 16, 128, 512};
+  for (int v : tokenCounts) {
+    ConsistentHashRing before(WORKERS, v), after(WORKERS + 1, v);
+    printMoves("ring, " + std::to_string(v) + " tokens",
+               countMoves(WORKERS,
+                          [&](int key) { return before.workerFor(key); },
+                          [&](int key) { return after.workerFor(key); }),
+               WORKERS + 1);
+  }
+
+  printMoves("jumpConsistentHash",
+             countMoves(WORKERS,
+                        [](int key) {
+                          return jumpConsistentHash(mix64(key), WORKERS);
+                        },
+                        [](int key) {
+                          return jumpConsistentHash(mix64(key), WORKERS + 1);
+                        }),
+             WORKERS + 1);
+
+  // lookup cost with 64 workers
+  ConsistentHashRing big(64);
+  cout << "\nLookup, 64 workers:\n";
+  cout << "  key % workers        " << std::setprecision(1) << std::setw(6)
+       << nsPerLookup([](int key) { return key % 64; }) << " ns\n";
+  cout << "  ring, 128 tokens     " << std::setw(6)
+       << nsPerLookup([&](int key) { return big.workerFor(key); }) << " ns ("
+       << big.getBytes() / 1024 << " KB of tokens)\n";
+  cout << "  jumpConsistentHash   " << std::setw(6)
+       << nsPerLookup(
+              [](int key) { return jumpConsistentHash(mix64(key), 64); })
+       << " ns\n\n";
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+200000 keys on 8 workers, 128 tokens each:
+  worker 0: 20828 keys
+  worker 1: 26398 keys
+  worker 2: 24859 keys
+  worker 3: 28220 keys
+  worker 4: 23161 keys
+  worker 5: 25837 keys
+  worker 6: 25896 keys
+  worker 7: 24801 keys
+
+Worker 8 joins, 23909 keys move to it, all from the other workers
+Key 4242 is on worker 7: v4242
+
+From 8 to 9 workers (ideal: 11.1% move)
+
+                           moved        busiest / average
+  key % workers           177776    88.9%      1.00
+  ring, 1 tokens           26608    13.3%      2.46
+  ring, 16 tokens          19896     9.9%      1.47
+  ring, 128 tokens         23909    12.0%      1.08
+  ring, 512 tokens         21223    10.6%      1.04
+  jumpConsistentHash       22294    11.1%      1.01
+
+Lookup, 64 workers:
+  key % workers           0.2 ns
+  ring, 128 tokens      104.8 ns (96 KB of tokens)
+  jumpConsistentHash     46.4 ns
+
+key % workers moves 8 of every 9 keys. The ring moves about 1/9 of them, and
+more tokens per worker even out the load. Jump consistent hash moves 1/9 too,
+with the most even load and no memory, but only the last worker can leave.
+On the ring any worker can leave, for the price of a binary search over the
+tokens.
+
+*/
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "ConsistentHashRing.hpp"
+
+// every step picks the next bucket the key jumps to, with a chance that only
+// depends on how many buckets there are so far
+int jumpConsistentHash(uint64_t key, int buckets) {
+  long long bucket = -1, next = 0;
+  while (next < buckets) {
+    bucket = next;
+    key = key * 2862933555777941757ULL + 1;  // 64-bit LCG
+    next = (long long)((bucket + 1) *
+                       ((double)(1LL << 31) / (double)((key >> 33) + 1)));
+  }
+  return (int)bucket;
+}
+
+ConsistentHashRing::ConsistentHashRing(int workers, int tokensPerWorker,
+                                       uint64_t ringSeed)
+    : virtualNodes(tokensPerWorker), seed(ringSeed), workerCount(0) {
+  if (tokensPerWorker <= 0) {
+    throw std::invalid_argument("Error! A worker needs a token.\n");
+  }
+  for (int worker = 0; worker < workers; worker++) {
+    addWorker(worker);
+  }
+}
+
+// the place of token i of the worker, the same on every run with one seed
+uint64_t ConsistentHashRing::tokenOf(int worker, int i) const {
+  return mix64(seed ^ mix64((uint64_t)(uint32_t)worker << 32 | (uint32_t)i));
+}
+
+// the index of the first token at or after the hash value, wrapping around to
+// the first token. A binary search for the lower bound: unlike the one in
+// BinarySearch.cpp it does not need the exact value
+size_t ConsistentHashRing::findToken(uint64_t hashVal) const {
+  size_t left = 0, right = tokens.size();
+  while (left < right) {
+    size_t mid = left + (right - left) / 2;
+    if (tokens[mid] < hashVal) {
+      left = mid + 1;  // the token is in the right half
+    } else {
+      right = mid;  // mid or something in the left half
+    }
+  }
+  return left == tokens.size() ? 0 : left;
+}
+
+void ConsistentHashRing::addWorker(int worker) {
+  if (worker < 0) {
+    throw std::invalid_argument("Error! Workers are numbered from 0.\n");
+  }
+  if (hasWorker(worker)) {
+    throw std::invalid_argument("Error! The worker is already on the ring.\n");
+  }
+
+  std::vector<std::pair<uint64_t, int>> ring;
+  ring.reserve(tokens.size() + virtualNodes);
+  for (size_t i = 0; i < tokens.size(); i++) {
+    ring.emplace_back(tokens[i], owners[i]);
+  }
+  for (int i = 0; i < virtualNodes; i++) {
+    ring.emplace_back(tokenOf(worker, i), worker);
+  }
+  // the old tokens are sorted already, merge the new ones in
+  std::sort(ring.end() - virtualNodes, ring.end());
+  std::inplace_merge(ring.begin(), ring.end() - virtualNodes, ring.end());
+
+  tokens.resize(ring.size());
+  owners.resize(ring.size());
+  for (size_t i = 0; i < ring.size(); i++) {
+    tokens[i] = ring[i].first;
+    owners[i] = ring[i].second;
+  }
+  workerCount++;
+}
+
+// returns false if the worker is not on the ring
+bool ConsistentHashRing::removeWorker(int worker) {
+  if (!hasWorker(worker)) {
+    return false;
+  }
+
+  size_t kept = 0;
+  for (size_t i = 0; i < tokens.size(); i++) {
+    if (owners[i] != worker) {
+      tokens[kept] = tokens[i];
+      owners[kept] = owners[i];
+      kept++;
+    }
+  }
+  tokens.resize(kept);
+  owners.resize(kept);
+  workerCount--;
+  return true;
+}
+
+bool ConsistentHashRing::hasWorker(int worker) const {
+  return std::find(owners.begin(), owners.end(), worker) != owners.end();
+}
+
+// the worker that owns the key
+int ConsistentHashRing::workerFor(uint64_t key) const {
+  return workerForHash(mix64(key ^ seed));
+}
+
+// the worker that owns a 64-bit hash value that was already computed
+int ConsistentHashRing::workerForHash(uint64_t hashVal) const {
+  if (tokens.empty()) {
+    throw std::out_of_range("Error! The ring has no workers.\n");
+  }
+  return owners[findToken(hashVal)];
+}
+
+int ConsistentHashRing::getWorkerCount() const { return workerCount; }
+
+int ConsistentHashRing::getVirtualNodes() const { return virtualNodes; }
+
+size_t ConsistentHashRing::getBytes() const {
+  return tokens.capacity() * sizeof(uint64_t) +
+         owners.capacity() * sizeof(int);
+}
@@ -0,0 +1,96 @@
+#ifndef CONSISTENT_HASH_RING
+#define CONSISTENT_HASH_RING
+
+#include <cstdint>
+#include <iostream>  // preprocessor directive
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+Sharding splits the keys over a number of workers (threads, tables, servers).
+Every worker owns its own table, so nobody takes a lock. The simple way:
+
+  worker = key % workers
+
+works until the number of workers changes. With 8 workers key 20 goes to
+worker 4, with 9 workers to worker 2: nearly every key moves, and every worker
+starts again with a cold cache. Consistent hashing moves only about 1/n of the
+keys when the n-th worker comes or goes.
+
+Consistent Hash Ring:
+The hash values form a ring (2^64 wraps around to 0). Every worker puts a
+number of tokens on the ring, at the hash of (worker, token number). A key
+belongs to the first token at or after its own hash, going around the ring:
+
+                 0
+             .-------.          tokens: A at 10, B at 35, A at 60, B at 85
+        85 B/         \ 10 A    (out of 100 here, 2^64 really)
+          |           |
+          |           |         key hash 42  -->  token 60  -->  worker A
+        60 A\         / 35 B    key hash 90  -->  wraps to 10 -> worker A
+             '-------'
+
+A new worker C puts its tokens on the ring, and only the keys between each of
+its tokens and the token before it move, all of them to C. Every other key
+stays where it was.
+
+ * Virtual nodes: one token per worker gives arcs of very different lengths,
+   so some workers own far more keys than others. With v tokens per worker the
+   load evens out, the largest share is about 1 + O(sqrt(log n / v)) times the
+   average. 100 to 200 tokens per worker is common
+ * The tokens are kept in one sorted array, with the owner of every token in a
+   second array next to it. A lookup is a binary search for the first token
+   at or after the hash of the key (Check the BinarySearch.cpp in Search), one
+   cache miss per step for a big ring
+ * Any worker can leave, not only the last one
+
+Jump Consistent Hash:
+No tokens and no memory at all: jumpConsistentHash(key, n) jumps through the
+buckets with a random generator seeded by the key, and returns the last
+bucket below n. Going from n to n + 1 buckets moves exactly the keys that now
+land in bucket n, about 1/(n + 1) of them, and the load is as even as it gets.
+But the workers must be numbered 0 to n - 1 and only the last one can leave.
+
+ Time Complexity: O(log(n * v)) per lookup on the ring, O(log n) for jump,
+                  O(n * v) to add or remove a worker
+
+ Space complexity: O(n * v) for the ring, O(1) for jump
+
+*/
+
+// the bucket from 0 to buckets - 1 of the key, Lamping and Veach
+int jumpConsistentHash(uint64_t, int);
+
+class ConsistentHashRing {
+ private:
+  int virtualNodes;  // tokens per worker
+  uint64_t seed;
+  std::vector<uint64_t> tokens;  // sorted
+  std::vector<int> owners;       // the worker of tokens[i]
+  int workerCount;
+
+  uint64_t tokenOf(int, int) const;
+  size_t findToken(uint64_t) const;
+
+ public:
+  // constructor, workers 0 .. workers - 1 with virtualNodes tokens each
+  ConsistentHashRing(int = 0, int = 128, uint64_t = 0);
+
+  void addWorker(int);
+  bool removeWorker(int);
+  bool hasWorker(int) const;
+
+  int workerFor(uint64_t) const;
+  int workerForHash(uint64_t) const;
+
+  int getWorkerCount() const;
+  int getVirtualNodes() const;
+  size_t getBytes() const;
+};
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef COUNT_MIN_SKETCH
+#define COUNT_MIN_SKETCH
+
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+/*
+
+A Count-Min Sketch estimates how often every key of a stream has been seen, in
+a fixed amount of memory. It never counts too low, but may count too high.
+
+It is a grid of counters with d rows of w counters. Every row has its own hash
+function. Adding a key adds 1 to one counter in every row; the estimate of a
+key is the smallest of its d counters:
+
+            0   1   2   3   4   5   6   7       add "a" 3 times, "b" once
+                                                (without conservative update)
+          +---+---+---+---+---+---+---+---+
+  row 0   | 0 | 3 | 0 | 0 | 0 | 1 | 0 | 0 |     "a" --> 1, "b" --> 5
+          +---+---+---+---+---+---+---+---+
+  row 1   | 0 | 0 | 0 | 4 | 0 | 0 | 0 | 0 |     "a" --> 3, "b" --> 3 (collide)
+          +---+---+---+---+---+---+---+---+
+  row 2   | 1 | 0 | 0 | 0 | 0 | 0 | 3 | 0 |     "a" --> 6, "b" --> 0
+          +---+---+---+---+---+---+---+---+
+
+  estimate("a") = min(3, 4, 3) = 3
+  estimate("b") = min(1, 4, 1) = 1      row 1 counts too high, the min hides it
+
+Every counter of a key holds its own count plus the counts of the keys that
+collide with it. With w = e / epsilon counters per row and d = ln(1 / delta)
+rows, an estimate is too high by more than epsilon * (stream length) with a
+chance of at most delta.
+
+ * The key is hashed once. Every row mixes that 64-bit hash with its own
+   number (mix64 of hash + row), so the rows do not collide together: the
+   shortcut h1 + i * h2 (double hashing) only keeps a few bits of h1 and h2
+   with a small width, and two keys that collide in one row then collide in
+   every row
+ * Conservative update: adding a key only raises the counters that are below
+   the new estimate. The other counters already count too high, so raising
+   them would only add error for other keys. Estimates stay upper bounds
+
+  CountMinSketch<Hash>
+                 |
+                 +-- turns a key into 64 bits (default: Mix64Hash)
+
+ Time Complexity: O(d) per add and per estimate
+
+ Space complexity: O(w * d), independent of the number of keys
+
+*/
+
+template <typename Hash = Mix64Hash>
+class CountMinSketch {
+ private:
+  size_t width;  // counters per row, a power of two
+  int depth;     // rows
+  std::vector<uint32_t> counters;
+  Hash hasher;
+
+  size_t indexOf(uint64_t hashVal, int row) const {
+    uint64_t rowHash = mix64(hashVal + (uint64_t)row * 0x9e3779b97f4a7c15ULL);
+    return row * width + (rowHash & (width - 1));
+  }
+
+ public:
+  // constructor, the width is rounded up to a power of two
+  CountMinSketch(size_t w = 2048, int d = 4, const Hash& hash = Hash())
+      : depth(d), hasher(hash) {
+    if (w == 0 || d <= 0) {
+      throw std::invalid_argument("Error! The sketch needs counters.\n");
+    }
+    width = 1;
+    while (width < w) {
+      width *= 2;
+    }
+    counters.assign(width * depth, 0);
+  }
+
+  // the size for an error of at most epsilon * (stream length), with a chance
+  // of delta of going over it
+  static CountMinSketch withError(double epsilon, double delta,
+                                  const Hash& hash = Hash()) {
+    return CountMinSketch((size_t)std::ceil(std::exp(1.0) / epsilon),
+                          (int)std::ceil(std::log(1 / delta)), hash);
+  }
+
+  // adds count to the key, returns the new estimate of the key
+  template <typename K>
+  uint32_t add(const K& key, uint32_t count = 1) {
+    uint64_t hashVal = (uint64_t)hasher(key);
+    uint32_t target = estimateHash(hashVal) + count;
+    for (int row = 0; row < depth; row++) {
+      uint32_t& counter = counters[indexOf(hashVal, row)];
+      if (counter < target) {
+        counter = target;
+      }
+    }
+    return target;
+  }
+
+  template <typename K>
+  uint32_t estimate(const K& key) const {
+    return estimateHash((uint64_t)hasher(key));
+  }
+
+  uint32_t estimateHash(uint64_t hashVal) const {
+    uint32_t smallest = UINT32_MAX;
+    for (int row = 0; row < depth; row++) {
+      uint32_t counter = counters[indexOf(hashVal, row)];
+      if (counter < smallest) {
+        smallest = counter;
+      }
+    }
+    return smallest;
+  }
+
+  size_t getWidth() const { return width; }
+
+  int getDepth() const { return depth; }
+
+  size_t getBytes() const { return counters.capacity() * sizeof(uint32_t); }
+};
+
+#endif
@@ -0,0 +1,59 @@
+#include "CuckooHashTable.cpp"
+
+int main() {
+  // declaration
+  CuckooHashTable table(16, 2024);  // 4 buckets of 4 slots, a fixed seed
+  int keys[] = {1, 2, 3, 4, 5, 42, 100, 2024, 7, 8, 9};
+
+  for (int key : keys) {
+    table.add(key);
+  }
+  table.remove(3);
+
+  cout << "\nTable (" << table.getCount() << " keys, " << table.getSize()
+       << " slots):\n";
+  table.printTable();
+
+  int lookups[] = {42, 3, 6};
+  cout << "\n";
+  for (int key : lookups) {
+    int index = table.search(key);
+    if (index != -1) {
+      cout << "...Found " << key << " at slot " << index << "\n";
+    } else {
+      cout << "...Number " << key << " not found!\n";
+    }
+  }
+
+  // keep adding until the buckets of some key are full for good
+  int key = 10;
+  while (table.getSize() == 16) {
+    table.add(key++);
+  }
+  cout << "\nThe table grew while adding " << key - 1 << ": "
+       << table.getCount() << " keys, " << table.getSize() << " slots\n\n";
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+Table (10 keys, 16 slots):
+Bucket 0: | 1 | 9 | _ | _ |
+Bucket 1: | _ | 7 | 8 | _ |
+Bucket 2: | 2 | 4 | 100 | _ |
+Bucket 3: | 5 | 42 | 2024 | _ |
+Stash: (Empty)
+
+...Found 42 at slot 13
+...Number 3 not found!
+...Number 6 not found!
+
+The table grew while adding 20: 21 keys, 32 slots
+
+Every search looked at two buckets and the stash at most. Before adding 20, all
+16 slots were used and the stash held 4 more keys (16, 42, 100 and 2), so the
+table only grew when it held 20 keys for 16 slots.
+
+*/
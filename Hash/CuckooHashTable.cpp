@@ -0,0 +1,256 @@
+#include "CuckooHashTable.hpp"
+
+CuckooHashTable::CuckooHashTable(int tableSize, uint64_t seed)
+    : count(0), hasher(seed), random(mix64(hasher.k1) | 1) {
+  // tableSize counts slots, round the buckets up to a power of two (at least 2,
+  // so that a key can have two different buckets)
+  buckets = 2;
+  while (buckets * SLOTS < tableSize) {
+    buckets *= 2;
+  }
+  table.assign(buckets, Bucket());
+}
+/*
+
+For example, tableSize = 16: 4 buckets of 4 slots
+
+              slot 0  slot 1  slot 2  slot 3
+            +-------+-------+-------+-------+
+  bucket 0  |       |       |       |       |
+            +-------+-------+-------+-------+
+  bucket 1  |       |       |       |       |
+            +-------+-------+-------+-------+
+  bucket 2  |       |       |       |       |
+            +-------+-------+-------+-------+
+  bucket 3  |       |       |       |       |
+            +-------+-------+-------+-------+
+
+  stash     (empty)
+
+*/
+
+uint64_t CuckooHashTable::hash(int key) const {
+  return hasher((uint64_t)key);
+}
+
+int CuckooHashTable::firstBucket(uint64_t hashVal) const {
+  return (int)(hashVal & (buckets - 1));
+}
+
+// the first bucket xor a tag from 1 to buckets - 1: never the first bucket, so
+// every key has two buckets to choose from
+int CuckooHashTable::secondBucket(uint64_t hashVal) const {
+  uint64_t tag = (((hashVal >> 32) * (uint64_t)(buckets - 1)) >> 32) + 1;
+  return firstBucket(hashVal) ^ (int)tag;
+}
+
+int CuckooHashTable::getSize() const { return buckets * SLOTS; }
+
+int CuckooHashTable::getCount() const { return count; }
+
+int CuckooHashTable::getStashCount() const { return (int)stash.size(); }
+
+// puts the key into a free slot of the bucket, if there is one
+bool CuckooHashTable::putInBucket(int key, int index) {
+  Bucket& bucket = table[index];
+  for (int i = 0; i < SLOTS; i++) {
+    if (!(bucket.used & (1 << i))) {
+      bucket.keys[i] = key;
+      bucket.used |= 1 << i;
+      return true;
+    }
+  }
+  return false;
+}
+
+// puts the key into one of its buckets, evicting other keys if needed. If the
+// eviction path gets too long, returns false and key holds the key that is left
+// without a slot (not necessarily the one we started with)
+bool CuckooHashTable::place(int& key) {
+  uint64_t hashVal = hash(key);
+  int index = firstBucket(hashVal);
+  if (putInBucket(key, index) || putInBucket(key, secondBucket(hashVal))) {
+    return true;
+  }
+
+  for (int kick = 0; kick < MAX_KICKS; kick++) {
+    // a random victim, so that two keys cannot keep evicting each other
+    random ^= random << 13;
+    random ^= random >> 7;
+    random ^= random << 17;
+    int slot = (int)(random % SLOTS);
+    std::swap(key, table[index].keys[slot]);
+
+    // the evicted key goes to its other bucket
+    hashVal = hash(key);
+    index = firstBucket(hashVal) == index ? secondBucket(hashVal)
+                                          : firstBucket(hashVal);
+    if (putInBucket(key, index)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+/*
+
+Adding 7 (buckets 1 and 2) to a full neighborhood, SLOTS = 2 to keep the
+picture small:
+
+  bucket 1  |  3 |  9 |       7 evicts 9          bucket 1  |  3 |  7 |
+  bucket 2  |  4 | 15 |                           bucket 2  |  4 | 15 |
+  bucket 3  | 11 |  _ |       9 -> bucket 3       bucket 3  | 11 |  9 |
+
+7 could not use bucket 1 or 2, so it took the slot of 9. The other bucket of 9 is
+bucket 3, which had room. The path had one eviction.
+
+*/
+
+// doubles the number of buckets (more if needed) and adds every key again,
+// together with the key that could not be placed
+void CuckooHashTable::grow(int homeless) {
+  std::vector<int> keys(stash);
+  keys.push_back(homeless);
+  for (const Bucket& bucket : table) {
+    for (int i = 0; i < SLOTS; i++) {
+      if (bucket.used & (1 << i)) {
+        keys.push_back(bucket.keys[i]);
+      }
+    }
+  }
+
+  bool done = false;
+  while (!done) {
+    buckets *= 2;
+    table.assign(buckets, Bucket());
+    stash.clear();
+    done = true;
+
+    for (int key : keys) {
+      if (!place(key)) {
+        if ((int)stash.size() == STASH_SIZE) {
+          // very unlucky, try again with even more buckets
+          done = false;
+          break;
+        }
+        stash.push_back(key);
+      }
+    }
+  }
+}
+
+bool CuckooHashTable::add(int key) {
+  // every key is stored only once
+  if (search(key) != -1) {
+    return false;
+  }
+
+  count++;
+  if (place(key)) {
+    return true;
+  }
+
+  // key is now whichever key was left over at the end of the eviction path
+  if ((int)stash.size() < STASH_SIZE) {
+    stash.push_back(key);
+  } else {
+    grow(key);
+  }
+  return true;
+}
+
+// returns the slot of the key (bucket * SLOTS + slot), stash entries come after
+// the last bucket, or -1 if the key is not in the table
+int CuckooHashTable::search(int key) const {
+  uint64_t hashVal = hash(key);
+  int candidates[2] = {firstBucket(hashVal), secondBucket(hashVal)};
+  // both buckets are known up front, so both cache lines can load at once
+  prefetch(&table[candidates[1]]);
+
+  for (int index : candidates) {
+    const Bucket& bucket = table[index];
+    for (int i = 0; i < SLOTS; i++) {
+      if ((bucket.used & (1 << i)) && bucket.keys[i] == key) {
+        return index * SLOTS + i;
+      }
+    }
+  }
+
+  for (int i = 0; i < (int)stash.size(); i++) {
+    if (stash[i] == key) {
+      return buckets * SLOTS + i;
+    }
+  }
+
+  return -1;
+}
+/*
+
+Searching 9 (buckets 1 and 3):
+
+  bucket 1  |  3 |  7 |  not here
+  bucket 3  | 11 |  9 |  found!
+  stash     (not needed)
+
+Searching 20 (buckets 0 and 2):
+
+  bucket 0  |  _ |  _ |  not here
+  bucket 2  |  4 | 15 |  not here
+  stash     |  8 |       not here, 20 is not in the table
+
+No matter how full the table is, a search never looks anywhere else.
+
+*/
+
+bool CuckooHashTable::remove(int key) {
+  int index = search(key);
+
+  if (index == -1) {
+    return false;
+  }
+
+  count--;
+
+  if (index >= buckets * SLOTS) {
+    stash.erase(stash.begin() + (index - buckets * SLOTS));
+    return true;
+  }
+
+  table[index / SLOTS].used &= ~(1 << (index % SLOTS));
+
+  // a key in the stash may fit into the slot that just became free
+  for (size_t i = 0; i < stash.size(); i++) {
+    uint64_t hashVal = hash(stash[i]);
+    if (firstBucket(hashVal) == index / SLOTS ||
+        secondBucket(hashVal) == index / SLOTS) {
+      putInBucket(stash[i], index / SLOTS);
+      stash.erase(stash.begin() + i);
+      break;
+    }
+  }
+
+  return true;
+}
+
+void CuckooHashTable::printTable() const {
+  for (int i = 0; i < buckets; i++) {
+    cout << "Bucket " << i << ": ";
+    for (int j = 0; j < SLOTS; j++) {
+      if (table[i].used & (1 << j)) {
+        cout << "| " << table[i].keys[j] << " ";
+      } else {
+        cout << "| _ ";
+      }
+    }
+    cout << "|\n";
+  }
+
+  cout << "Stash: ";
+  if (stash.empty()) {
+    cout << "(Empty)";
+  }
+  for (int key : stash) {
+    cout << key << " ";
+  }
+  cout << "\n";
+}
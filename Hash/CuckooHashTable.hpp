@@ -0,0 +1,112 @@
+#ifndef CUCKOO_HASH_TABLE
+#define CUCKOO_HASH_TABLE
+
+#include <cstdint>
+#include <iostream>  // preprocessor directive
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+Cuckoo Hashing gives every key exactly two buckets it may live in, picked by two
+hash functions. A search looks at those two buckets and nowhere else, so even
+the worst search is O(1). (Linear probing in HashTable.cpp can walk a whole
+cluster.)
+
+Adding a key when both of its buckets are full kicks out one of the keys that
+are there, like a cuckoo chick pushing an egg out of the nest. The evicted key
+moves to its other bucket, which may evict another key, and so on:
+
+  add 7, both buckets of 7 are full
+
+  bucket 2  | 12 | 30 | 41 |  5 |   --> 7 takes the slot of 30
+  bucket 5  | 30 | .. | .. |  _ |   --> 30 moves to its other bucket, which
+                                        has an empty slot. Done!
+
+ * Buckets: every bucket has SLOTS (4) slots, so a bucket is full much later
+   than a single slot would be. With 4 slots per bucket the table works well up
+   to about 95% full. One bucket is 32 bytes and never crosses a cache line.
+ * Bounded path: a chain of evictions stops after MAX_KICKS moves.
+ * Stash: the key that is left over after MAX_KICKS moves goes into a tiny
+   extra array (the stash, at most STASH_SIZE keys) instead of making the whole
+   table grow at once.
+ * Growth: only when the stash is full too, the table doubles its number of
+   buckets and every key is inserted again.
+
+Both hash functions come from one seeded SipHash value (Check the
+HashFunctions.hpp): the low 32 bits pick the first bucket. The high 32 bits
+pick a tag from 1 to buckets - 1, and the second bucket is the first one xor
+the tag. Two separate picks would land in the same bucket once in every
+"buckets" keys, and such a key would have nowhere else to go.
+
+ Time Complexity
+ +------------+-----------+-----------+
+ | Operation  | Worst     | Average   |
+ +------------+-----------+-----------+
+ | Search     | O(1)      | O(1)      |
+ | Insertion  | O(n)*     | O(1)      |
+ | Deletion   | O(1)      | O(1)      |
+ +------------+-----------+-----------+
+ * Only when the table has to grow. Without growth an add makes at most
+   MAX_KICKS moves.
+
+ Space complexity: O(n)
+
+ Pros:
+ * A search compares at most 2 * SLOTS + STASH_SIZE keys and touches at most
+   two buckets (two cache lines) plus the stash
+ * A missing key costs the same as a present one
+ * No tombstones: a removed key simply frees its slot
+
+ Cons:
+ * Adding can be slow when the table is nearly full (long eviction paths)
+ * Keys move during an add, so an index returned by search is only valid until
+   the next add
+
+*/
+
+class CuckooHashTable {
+ private:
+  static constexpr int SLOTS = 4;
+  static constexpr int STASH_SIZE = 4;
+  static constexpr int MAX_KICKS = 256;
+
+  // 4 keys and the bit mask of the used slots, in one 32-byte block
+  struct alignas(32) Bucket {
+    int keys[SLOTS];
+    uint8_t used;  // bit i is set if keys[i] holds a key
+  };
+
+  int buckets;  // always a power of two
+  int count;
+  SeededHash hasher;  // SipHash with the secret key of this table
+  uint64_t random;    // picks the slot to evict
+  std::vector<Bucket> table;
+  std::vector<int> stash;
+
+  uint64_t hash(int) const;
+  int firstBucket(uint64_t) const;
+  int secondBucket(uint64_t) const;
+  bool putInBucket(int, int);
+  bool place(int&);
+  void grow(int);
+
+ public:
+  // constructor
+  CuckooHashTable(int = 16, uint64_t = randomSeed());
+
+  bool add(int);
+  bool remove(int);
+  int search(int) const;
+
+  int getSize() const;
+  int getCount() const;
+  int getStashCount() const;
+  void printTable() const;
+};
+
+#endif
@@ -0,0 +1,94 @@
+#include <cstdio>
+
+#include "ExtendibleHashTable.cpp"
+
+int main() {
+  const std::string path = "ExtendibleDemo.db";
+  std::remove(path.c_str());
+  std::remove((path + ".dir").c_str());
+
+  {
+    // declaration
+    ExtendibleHashTable table(path, 4, 2024);  // 4 cached pages, a fixed seed
+    // about 4 pages of keys, every value is its key times 10
+    for (int key = 1; key <= 2000; key++) {
+      table.add(key, key * 10);
+    }
+    table.remove(30);
+
+    cout << "\nTable (" << table.getCount() << " keys, " << table.getPageCount()
+         << " pages of " << ExtendibleHashTable::PAGE_SIZE
+         << " bytes, globalDepth " << table.getGlobalDepth() << "):\n";
+    table.printDirectory();
+    cout << "page reads " << table.getPageReads() << ", page writes "
+         << table.getPageWrites() << "\n";
+  }  // the destructor writes everything to the files
+
+  {
+    // open the same files again, the directory and the seed come back with them
+    ExtendibleHashTable table(path, 4);
+    cout << "\nOpened again: " << table.getCount() << " keys, "
+         << table.getPageCount() << " pages\n\n";
+
+    int lookups[] = {70, 30, 1999, 2500};
+    for (int key : lookups) {
+      long long before = table.getPageReads();
+      int val;
+      if (table.search(key, val)) {
+        cout << "...Found " << key << " -> " << val;
+      } else {
+        cout << "...Number " << key << " not found!";
+      }
+      cout << " (" << table.getPageReads() - before << " page read)\n";
+    }
+
+    // many more keys than the 4 cached pages can hold
+    for (int key = 2001; key <= 200000; key++) {
+      table.add(key, key * 10);
+    }
+    long long before = table.getPageReads();
+    int found = 0;
+    for (int i = 0; i < 10000; i++) {
+      int key = (int)(mix64(i) % 200000) + 1;
+      int val;
+      found += table.search(key, val);
+    }
+    cout << "\n" << table.getCount() << " keys in " << table.getPageCount()
+         << " pages, " << found << " of 10000 random keys found with "
+         << table.getPageReads() - before << " page reads\n\n";
+  }
+
+  std::remove(path.c_str());
+  std::remove((path + ".dir").c_str());
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+Table (1999 keys, 6 pages of 4096 bytes, globalDepth 3):
+Entry 000 -> page 0
+Entry 001 -> page 1
+Entry 010 -> page 3
+Entry 011 -> page 2
+Entry 100 -> page 0
+Entry 101 -> page 4
+Entry 110 -> page 3
+Entry 111 -> page 5
+page reads 20, page writes 22
+
+Opened again: 1999 keys, 6 pages
+
+...Found 70 -> 700 (1 page read)
+...Number 30 not found! (1 page read)
+...Found 1999 -> 19990 (1 page read)
+...Number 2500 not found! (1 page read)
+
+199999 keys in 512 pages, 10000 of 10000 random keys found with 9930 page reads
+
+Page 0 has localDepth 2 (hashes ending in 00), so entries 000 and 100 share
+it. A search reads one page at most: every lookup above costs one read, and
+the random lookups only skip a read when their page is still cached.
+
+*/
@@ -0,0 +1,349 @@
+#include "ExtendibleHashTable.hpp"
+
+ExtendibleHashTable::ExtendibleHashTable(const std::string& filePath,
+                                         int cacheFrames, uint64_t seed)
+    : path(filePath),
+      hasher(seed),
+      globalDepth(0),
+      pageCount(0),
+      count(0),
+      frames(cacheFrames < 2 ? 2 : cacheFrames),
+      hand(0),
+      pageReads(0),
+      pageWrites(0) {
+  static_assert(sizeof(Page) == PAGE_SIZE, "a page must fill a disk page");
+
+  if (load()) {
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+  } else if (std::ifstream(path)) {
+    // pages without their directory (a crash before the first flush, or a
+    // lost .dir file): they cannot be read, but must not be wiped either
+    throw std::runtime_error("Error! " + path + " has no valid " + path +
+                             ".dir.\n");
+  } else {
+    // a new table, trunc creates the file
+    file.open(path, std::ios::in | std::ios::out | std::ios::binary |
+                        std::ios::trunc);
+    if (file) {
+      // one empty page, every key starts there
+      directory.assign(1, 0);
+      pageCount = 1;
+      Frame& frame = frameFor(0, false);
+      frame.page.localDepth = 0;
+      frame.page.count = 0;
+      frame.dirty = true;
+    }
+  }
+
+  if (!file) {
+    throw std::runtime_error("Error! Cannot open " + path + ".\n");
+  }
+}
+/*
+
+For example, a new table: globalDepth 0, one directory entry, one page
+
+  directory  (0 bits) ---> page 0 (localDepth 0, 0 keys, room for 511)
+
+*/
+
+// writes back the changed pages and the directory. A destructor must not
+// throw, so a failed write is only reported (call flush to catch it)
+ExtendibleHashTable::~ExtendibleHashTable() {
+  try {
+    flush();
+  } catch (const std::exception& e) {
+    std::cerr << e.what();
+  }
+}
+
+size_t ExtendibleHashTable::hash(int key) const {
+  return hasher((uint64_t)key);
+}
+
+// the page that holds the key, if the key is in the table
+int ExtendibleHashTable::pageOf(int key) const {
+  return directory[hash(key) & (directory.size() - 1)];
+}
+
+long long ExtendibleHashTable::getCount() const { return count; }
+
+int ExtendibleHashTable::getGlobalDepth() const { return globalDepth; }
+
+int ExtendibleHashTable::getPageCount() const { return pageCount; }
+
+long long ExtendibleHashTable::getPageReads() const { return pageReads; }
+
+long long ExtendibleHashTable::getPageWrites() const { return pageWrites; }
+
+void ExtendibleHashTable::writePage(Frame& frame) {
+  file.seekp((std::streamoff)frame.pageId * PAGE_SIZE);
+  file.write((const char*)&frame.page, PAGE_SIZE);
+  if (!file) {
+    throw std::runtime_error("Error! Cannot write " + path + ".\n");
+  }
+  frame.dirty = false;
+  pageWrites++;
+}
+
+// the frame that holds the page. A page that is not cached takes the frame of
+// the page the clock picks, and is read from the file if read is true (a new
+// page has nothing to read yet)
+ExtendibleHashTable::Frame& ExtendibleHashTable::frameFor(int pageId,
+                                                          bool read) {
+  int* cachedFrame = cached.find(pageId);
+  if (cachedFrame) {
+    frames[*cachedFrame].used = true;
+    return frames[*cachedFrame];
+  }
+
+  // the clock: a frame used since the hand last passed it gets another round
+  while (frames[hand].pageId != -1 && frames[hand].used) {
+    frames[hand].used = false;
+    hand = (hand + 1) % frames.size();
+  }
+  int index = (int)hand;
+  hand = (hand + 1) % frames.size();
+
+  Frame& frame = frames[index];
+  if (frame.pageId != -1) {
+    if (frame.dirty) {
+      writePage(frame);
+    }
+    cached.remove(frame.pageId);
+  }
+
+  frame.pageId = pageId;
+  frame.dirty = false;
+  frame.used = true;
+  cached.insert(pageId, index);
+
+  if (read) {
+    file.seekg((std::streamoff)pageId * PAGE_SIZE);
+    file.read((char*)&frame.page, PAGE_SIZE);
+    pageReads++;
+    if (!file) {
+      throw std::runtime_error("Error! Cannot read " + path + ".\n");
+    }
+  }
+
+  return frame;
+}
+/*
+
+A cache of 4 frames, the hand at frame 1 (* marks used):
+
+  frame     0          1          2          3
+        +--------+ +--------+ +--------+ +--------+
+        | page 7*| | page 2*| | page 9 | | page 4*|
+        +--------+ +--------+ +--------+ +--------+
+                       ^
+
+Fetching page 5: frame 1 is used, clear its mark and move on. Frame 2 is not
+used, page 9 leaves (written back first if it changed) and page 5 is read into
+frame 2. The hand stops at frame 3.
+
+*/
+
+ExtendibleHashTable::Frame& ExtendibleHashTable::fetch(int pageId) {
+  return frameFor(pageId, true);
+}
+
+// splits a full page in two by the next bit of the hash
+void ExtendibleHashTable::split(int pageId) {
+  // a copy: fetching the new page below may reuse the frame of this one
+  Page old = fetch(pageId).page;
+  int depth = old.localDepth;
+
+  if (depth == globalDepth) {
+    if (globalDepth == MAX_DEPTH) {
+      throw std::length_error("Error! The directory is too big.\n");
+    }
+
+    // the upper half of the new directory is a copy of the lower half
+    size_t half = directory.size();
+    directory.resize(half * 2);
+    for (size_t i = 0; i < half; i++) {
+      directory[half + i] = directory[i];
+    }
+    globalDepth++;
+  }
+
+  Page low, high;
+  low.localDepth = high.localDepth = depth + 1;
+  low.count = high.count = 0;
+  for (int i = 0; i < old.count; i++) {
+    Page& half = (hash(old.entries[i].key) >> depth) & 1 ? high : low;
+    half.entries[half.count++] = old.entries[i];
+  }
+
+  // the keys with bit depth set go to a new page at the end of the file
+  int sibling = pageCount++;
+  Frame& lowFrame = fetch(pageId);
+  lowFrame.page = low;
+  lowFrame.dirty = true;
+  Frame& highFrame = frameFor(sibling, false);
+  highFrame.page = high;
+  highFrame.dirty = true;
+
+  for (size_t i = 0; i < directory.size(); i++) {
+    if (directory[i] == pageId && ((i >> depth) & 1)) {
+      directory[i] = sibling;
+    }
+  }
+}
+/*
+
+Page 1 is full (localDepth 1, hashes ending in 1), globalDepth 1:
+
+  directory  0 ---> page 0
+             1 ---> page 1 (full)
+
+localDepth == globalDepth, so the directory doubles first:
+
+  directory  00 ---> page 0
+             01 ---> page 1
+             10 ---> page 0
+             11 ---> page 1
+
+Then page 1 splits by bit 1: hashes ending in 11 move to the new page 2.
+
+  directory  00 ---> page 0 (localDepth 1)
+             01 ---> page 1 (localDepth 2)
+             10 ---> page 0
+             11 ---> page 2 (localDepth 2)
+
+*/
+
+// returns true if the key is new, false if the old value is replaced
+bool ExtendibleHashTable::add(int key, int val) {
+  while (true) {
+    int pageId = pageOf(key);
+    Frame& frame = fetch(pageId);
+    Page& page = frame.page;
+
+    for (int i = 0; i < page.count; i++) {
+      if (page.entries[i].key == key) {
+        page.entries[i].val = val;
+        frame.dirty = true;
+        return false;
+      }
+    }
+
+    if (page.count < PAGE_CAPACITY) {
+      page.entries[page.count].key = key;
+      page.entries[page.count].val = val;
+      page.count++;
+      frame.dirty = true;
+      count++;
+      return true;
+    }
+
+    // the page is full: split it, then the key goes to one of the halves (or
+    // splits that one again, if every key went to the same half)
+    split(pageId);
+  }
+}
+
+bool ExtendibleHashTable::remove(int key) {
+  Frame& frame = fetch(pageOf(key));
+  Page& page = frame.page;
+
+  for (int i = 0; i < page.count; i++) {
+    if (page.entries[i].key == key) {
+      // the last entry fills the hole, a page has no order
+      page.entries[i] = page.entries[page.count - 1];
+      page.count--;
+      frame.dirty = true;
+      count--;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// val is set to the value of the key if it is found
+bool ExtendibleHashTable::search(int key, int& val) {
+  const Page& page = fetch(pageOf(key)).page;
+
+  for (int i = 0; i < page.count; i++) {
+    if (page.entries[i].key == key) {
+      val = page.entries[i].val;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// writes every changed page and the directory, the file is complete after it
+void ExtendibleHashTable::flush() {
+  for (Frame& frame : frames) {
+    if (frame.pageId != -1 && frame.dirty) {
+      writePage(frame);
+    }
+  }
+  file.flush();
+  if (!file) {
+    throw std::runtime_error("Error! Cannot write " + path + ".\n");
+  }
+  save();
+}
+
+const uint32_t EXTENDIBLE_MAGIC = 0x45585448;  // "EXTH"
+
+void ExtendibleHashTable::save() {
+  std::ofstream meta(path + ".dir", std::ios::binary | std::ios::trunc);
+  meta.write((const char*)&EXTENDIBLE_MAGIC, sizeof(EXTENDIBLE_MAGIC));
+  meta.write((const char*)&hasher.k0, sizeof(hasher.k0));
+  meta.write((const char*)&globalDepth, sizeof(globalDepth));
+  meta.write((const char*)&pageCount, sizeof(pageCount));
+  meta.write((const char*)&count, sizeof(count));
+  meta.write((const char*)directory.data(), directory.size() * sizeof(int));
+  meta.flush();
+  if (!meta) {
+    throw std::runtime_error("Error! Cannot write " + path + ".dir.\n");
+  }
+}
+
+// reads the seed, the counters and the directory of a table that was saved
+// before. Returns false if there is none
+bool ExtendibleHashTable::load() {
+  std::ifstream meta(path + ".dir", std::ios::binary);
+  uint32_t magic = 0;
+  if (!meta.read((char*)&magic, sizeof(magic)) || magic != EXTENDIBLE_MAGIC) {
+    return false;
+  }
+
+  uint64_t seed = 0;
+  meta.read((char*)&seed, sizeof(seed));
+  meta.read((char*)&globalDepth, sizeof(globalDepth));
+  meta.read((char*)&pageCount, sizeof(pageCount));
+  meta.read((char*)&count, sizeof(count));
+  if (!meta || globalDepth < 0 || globalDepth > MAX_DEPTH) {
+    throw std::runtime_error("Error! " + path + ".dir is damaged.\n");
+  }
+  hasher = SeededHash(seed);
+
+  directory.resize((size_t)1 << globalDepth);
+  meta.read((char*)directory.data(), directory.size() * sizeof(int));
+  if (!meta) {
+    throw std::runtime_error("Error! " + path + ".dir is damaged.\n");
+  }
+  return true;
+}
+
+void ExtendibleHashTable::printDirectory() const {
+  for (size_t i = 0; i < directory.size(); i++) {
+    cout << "Entry ";
+    // the lowest globalDepth bits of the hash, highest bit first
+    for (int bit = globalDepth - 1; bit >= 0; bit--) {
+      cout << ((i >> bit) & 1);
+    }
+    if (globalDepth == 0) {
+      cout << "(any)";
+    }
+    cout << " -> page " << directory[i] << "\n";
+  }
+}
@@ -0,0 +1,160 @@
+#ifndef EXTENDIBLE_HASH_TABLE
+#define EXTENDIBLE_HASH_TABLE
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>  // preprocessor directive
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "HashFunctions.hpp"
+#include "HashMap.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+Extendible Hashing keeps a table on disk, so it can hold more keys than fit in
+memory. The keys live in fixed-size pages of a file, and a small directory in
+memory tells which page holds which keys.
+
+The directory has 2^globalDepth entries. The lowest globalDepth bits of the
+hash of a key pick an entry, and the entry holds the number of a page:
+
+  globalDepth = 2                    pages in the file
+                                     +-------------------------+
+  directory  00 --------------------> page 0 (localDepth 1)    | hash ends in 0
+             01 ----------+     +---> |                         |
+             10 ----------|-----+    +-------------------------+
+             11 ---+      +---------> page 1 (localDepth 2)    | hash ends in 01
+                   |                 +-------------------------+
+                   +----------------> page 2 (localDepth 2)    | hash ends in 11
+                                     +-------------------------+
+
+A page with localDepth d holds the keys whose hashes share their lowest d bits,
+so 2^(globalDepth - d) directory entries point at it.
+
+Splitting: when a page is full, it is split in two by the next bit of the hash
+(bit d). The keys with that bit set move to a new page at the end of the file,
+and the directory entries with that bit set now point at the new page. Only
+the full page is touched, no other key moves. If d was already globalDepth, the
+directory first doubles: the new upper half is a copy of the lower half.
+
+  add to page 0 (full, localDepth 1 = globalDepth 1):
+
+  00 -> page 0     (hash ends in 00, localDepth 2)
+  01 -> page 1
+  10 -> page 2     (hash ends in 10, localDepth 2, new)
+  11 -> page 1
+
+ * A search costs one directory lookup in memory and at most one page read
+ * The directory is 4 bytes per entry. A 40 GB file holds about 10 million
+   pages of 4 KB, so the directory stays below 100 MB even when it has twice
+   as many entries as pages
+ * A few recently used pages stay in a page cache (clock replacement). A
+   changed page is written back when it leaves the cache, or at flush
+ * The hash is a seeded SipHash (Check the HashFunctions.hpp). The seed is
+   saved with the directory, so a table opened again finds its keys
+ * Removing a key never merges pages, the space is reused by later adds
+
+Files: the pages are in the file at path, the seed, the counters and the
+directory are in path + ".dir", written by flush (and the destructor). A
+failed write throws. The pages cannot be read without the directory, so a page
+file without a valid .dir is never opened, and never wiped either.
+
+ Time Complexity
+ +------------+-----------+-----------------------------------------+
+ | Operation  | Average   | Disk                                    |
+ +------------+-----------+-----------------------------------------+
+ | Search     | O(1)      | at most one page read                   |
+ | Insertion  | O(1)      | one page read, two pages after a split  |
+ | Deletion   | O(1)      | one page read                           |
+ +------------+-----------+-----------------------------------------+
+
+ Space complexity: O(n) on disk, O(number of pages) in memory
+
+*/
+
+class ExtendibleHashTable {
+ public:
+  static constexpr int PAGE_SIZE = 4096;  // bytes
+
+ private:
+  static constexpr int MAX_DEPTH = 30;
+
+  struct Entry {
+    int key;
+    int val;
+  };
+
+  static constexpr int PAGE_CAPACITY =
+      (PAGE_SIZE - 2 * (int)sizeof(int)) / (int)sizeof(Entry);
+
+  // exactly one page of the file
+  struct Page {
+    int localDepth;
+    int count;
+    Entry entries[PAGE_CAPACITY];
+  };
+
+  // a page held in memory
+  struct Frame {
+    int pageId;  // -1 if the frame is free
+    bool dirty;  // changed since it was read
+    bool used;   // the clock hand skips it once
+    Page page;
+
+    // constructor
+    Frame() : pageId(-1), dirty(false), used(false) {}
+  };
+
+  std::string path;
+  std::fstream file;
+  SeededHash hasher;  // SipHash with the secret key of this table
+  int globalDepth;
+  int pageCount;
+  long long count;
+  std::vector<int> directory;
+  std::vector<Frame> frames;
+  HashMap<int, int> cached;  // page id -> frame
+  size_t hand;               // the clock hand
+  long long pageReads;
+  long long pageWrites;
+
+  size_t hash(int) const;
+  int pageOf(int) const;
+  Frame& frameFor(int, bool);
+  Frame& fetch(int);
+  void writePage(Frame&);
+  void split(int);
+  bool load();
+  void save();
+
+ public:
+  // constructor, opens the table at path or creates it if it is not there.
+  // Throws if the page file is there but its .dir is missing or damaged
+  ExtendibleHashTable(const std::string&, int = 64, uint64_t = randomSeed());
+
+  // a table owns its file, so it cannot be copied
+  ExtendibleHashTable(const ExtendibleHashTable&) = delete;
+  ExtendibleHashTable& operator=(const ExtendibleHashTable&) = delete;
+
+  // destructor
+  ~ExtendibleHashTable();
+
+  bool add(int, int);
+  bool remove(int);
+  bool search(int, int&);
+  void flush();
+
+  long long getCount() const;
+  int getGlobalDepth() const;
+  int getPageCount() const;
+  long long getPageReads() const;
+  long long getPageWrites() const;
+  void printDirectory() const;
+};
+
+#endif
@@ -0,0 +1,186 @@
+#include <atomic>
+#include <thread>
+
+#include "HashAggregate.hpp"
+
+AggregateTable::AggregateTable(size_t tableSize) : count(0) {
+  size_t size = 16;
+  while (size < tableSize) {
+    size *= 2;
+  }
+  slots.assign(size, Slot());
+}
+
+size_t AggregateTable::getCount() const { return count; }
+
+// doubles the table, the stored hash values tell where every key goes
+void AggregateTable::grow() {
+  std::vector<Slot> oldSlots(slots.size() * 2, Slot());
+  oldSlots.swap(slots);
+
+  size_t mask = slots.size() - 1;
+  for (const Slot& slot : oldSlots) {
+    if (!slot.used) {
+      continue;
+    }
+    size_t index = slot.hashVal & mask;
+    while (slots[index].used) {
+      index = (index + 1) & mask;
+    }
+    slots[index] = slot;
+  }
+}
+
+// returns the aggregate of the key, adding an empty one if the key is new.
+// hashVal is mix64 of the key
+Aggregate& AggregateTable::find(int key, uint64_t hashVal) {
+  size_t mask = slots.size() - 1;
+  size_t index = hashVal & mask;
+
+  while (slots[index].used) {
+    if (slots[index].key == key) {
+      return slots[index].agg;
+    }
+    index = (index + 1) & mask;
+  }
+
+  // a new key: keep the load factor at or below 0.75
+  if ((count + 1) * 4 > slots.size() * 3) {
+    grow();
+    mask = slots.size() - 1;
+    index = hashVal & mask;
+    while (slots[index].used) {
+      index = (index + 1) & mask;
+    }
+  }
+
+  Slot& slot = slots[index];
+  slot.used = true;
+  slot.key = key;
+  slot.hashVal = hashVal;
+  count++;
+  return slot.agg;
+}
+
+// adds every aggregate of this table to the same key in other
+void AggregateTable::mergeInto(AggregateTable& other) const {
+  for (const Slot& slot : slots) {
+    if (slot.used) {
+      other.find(slot.key, slot.hashVal).merge(slot.agg);
+    }
+  }
+}
+
+void AggregateTable::appendTo(std::vector<Group>& groups) const {
+  for (const Slot& slot : slots) {
+    if (slot.used) {
+      groups.push_back(Group{slot.key, slot.agg});
+    }
+  }
+}
+
+HashAggregate::HashAggregate(int threadCount) : threads(threadCount) {
+  if (threads <= 0) {
+    threads = (int)std::thread::hardware_concurrency();
+  }
+  if (threads <= 0) {
+    threads = 1;
+  }
+}
+
+int HashAggregate::getThreads() const { return threads; }
+
+// the groups of keys[0 .. n - 1] with the aggregates of values[0 .. n - 1], in
+// no particular order
+std::vector<Group> HashAggregate::run(const int* keys, const long long* values,
+                                      size_t n) const {
+  // a thread is not worth starting for a few rows
+  const size_t minRows = 1 << 14;
+  int workers = threads;
+  if ((size_t)workers > n / minRows) {
+    workers = n / minRows > 0 ? (int)(n / minRows) : 1;
+  }
+
+  // local[t][p]: the table of thread t for partition p
+  std::vector<std::vector<AggregateTable>> local(
+      workers, std::vector<AggregateTable>(PARTITIONS));
+
+  // phase 1: every thread aggregates a slice of the rows into its own tables
+  auto preAggregate = [&](int t) {
+    size_t begin = n * t / workers;
+    size_t end = n * (t + 1) / workers;
+    std::vector<AggregateTable>& tables = local[t];
+
+    for (size_t i = begin; i < end; i++) {
+      uint64_t hashVal = mix64((uint64_t)keys[i]);
+      tables[hashVal >> (64 - PARTITION_BITS)].find(keys[i], hashVal).add(
+          values[i]);
+    }
+  };
+
+  // phase 2: every thread takes the next partition that nobody has merged yet
+  std::vector<std::vector<Group>> results(PARTITIONS);
+  std::atomic<int> next(0);
+  auto merge = [&]() {
+    int p;
+    while ((p = next++) < PARTITIONS) {
+      AggregateTable& into = local[0][p];
+      for (int t = 1; t < workers; t++) {
+        local[t][p].mergeInto(into);
+        local[t][p] = AggregateTable();  // give the memory back early
+      }
+      results[p].reserve(into.getCount());
+      into.appendTo(results[p]);
+    }
+  };
+
+  // the calling thread works too, as worker 0
+  std::vector<std::thread> pool;
+  for (int t = 1; t < workers; t++) {
+    pool.emplace_back(preAggregate, t);
+  }
+  preAggregate(0);
+  for (std::thread& worker : pool) {
+    worker.join();
+  }
+
+  pool.clear();
+  for (int t = 1; t < workers; t++) {
+    pool.emplace_back(merge);
+  }
+  merge();
+  for (std::thread& worker : pool) {
+    worker.join();
+  }
+
+  size_t total = 0;
+  for (const std::vector<Group>& part : results) {
+    total += part.size();
+  }
+  std::vector<Group> groups;
+  groups.reserve(total);
+  for (const std::vector<Group>& part : results) {
+    groups.insert(groups.end(), part.begin(), part.end());
+  }
+  return groups;
+}
+/*
+
+Two threads, two partitions (P = 2 to keep the picture small), the partition
+of a key is shown in brackets:
+
+  rows   thread 0: 3[0] 7[1] 3[0]        thread 1: 9[1] 7[1] 3[0]
+
+  phase 1:
+    thread 0   p0: {3: sum 30, count 2}   p1: {7: sum 5, count 1}
+    thread 1   p0: {3: sum 30, count 1}   p1: {9: sum 1, count 1},
+                                              {7: sum 5, count 1}
+
+  phase 2: thread 0 takes p0, thread 1 takes p1 (at the same time)
+    p0: {3: sum 60, count 3}
+    p1: {7: sum 10, count 2}, {9: sum 1, count 1}
+
+Key 7 was seen by both threads, but it lands in p1 in both, so only the thread
+that merges p1 ever touches it.
+
+*/
@@ -0,0 +1,138 @@
+#ifndef HASH_AGGREGATE
+#define HASH_AGGREGATE
+
+#include <cstdint>
+#include <iostream>  // preprocessor directive
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+Hash Aggregation (GROUP BY) takes a column of keys and a column of values and
+computes the sum, count, min and max of the values of every distinct key:
+
+  keys    3   7   3   9   7   3            key  sum  count  min  max
+  values  10  5   20  1   5   30   --->     3    60    3     10   30
+                                            7    10    2     5    5
+                                            9    1     1     1    1
+
+One hash table from key to aggregate does it in one pass: find the key (or add
+it) and update its aggregate. But only one thread can write to one table.
+
+Partitioned Parallel Aggregation:
+The rows are split between T threads, and the work runs in two phases. No
+thread ever takes a lock.
+
+1. Pre-aggregate: every thread aggregates its own rows into its own tables.
+   The highest bits of the hash pick one of P partitions, and a thread keeps
+   one table per partition. A key that repeats in a thread's rows (the usual
+   case for a GROUP BY) is folded into one entry right away.
+
+2. Merge: partition p of every thread holds the same keys, and no other
+   partition holds them. So the threads now take whole partitions, and merge
+   partition p of all T threads into one final table.
+
+  thread 0 rows --> [p0] [p1] [p2] [p3]
+  thread 1 rows --> [p0] [p1] [p2] [p3]
+  thread 2 rows --> [p0] [p1] [p2] [p3]
+                      |    |    |    |
+                      v    v    v    v      any free thread takes the next
+                    [p0] [p1] [p2] [p3]     partition and merges it alone
+
+ * The partition comes from the highest bits of the hash and the slot in a
+   table from the lowest bits, so the keys of one partition still spread over
+   all the slots
+ * A partition table is small: with many groups, it fits in the cache of the
+   thread that merges it
+ * The tables use linear probing (Check the HashTable.hpp) with the hash kept
+   next to the key, so a table grows without hashing its keys again
+
+ Time Complexity: O(n / T + groups) with T threads
+
+ Space complexity: O(groups * T) at most, every thread may see every key
+
+*/
+
+struct Aggregate {
+  long long sum;
+  long long count;
+  long long min;
+  long long max;
+
+  // constructor
+  Aggregate() : sum(0), count(0), min(0), max(0) {}
+
+  void add(long long val) {
+    sum += val;
+    min = count == 0 || val < min ? val : min;
+    max = count == 0 || val > max ? val : max;
+    count++;
+  }
+
+  void merge(const Aggregate& other) {
+    if (other.count == 0) {
+      return;
+    }
+    min = count == 0 || other.min < min ? other.min : min;
+    max = count == 0 || other.max > max ? other.max : max;
+    sum += other.sum;
+    count += other.count;
+  }
+};
+
+// one row of the result: a distinct key and the aggregate of its values
+struct Group {
+  int key;
+  Aggregate agg;
+};
+
+// a key -> aggregate table with linear probing, used by one thread at a time
+class AggregateTable {
+ private:
+  struct Slot {
+    uint64_t hashVal;
+    int key;
+    bool used;
+    Aggregate agg;
+
+    // constructor
+    Slot() : hashVal(0), key(0), used(false) {}
+  };
+
+  std::vector<Slot> slots;  // always a power of two
+  size_t count;
+
+  void grow();
+
+ public:
+  // constructor
+  AggregateTable(size_t = 16);
+
+  Aggregate& find(int, uint64_t);
+  void mergeInto(AggregateTable&) const;
+  void appendTo(std::vector<Group>&) const;
+
+  size_t getCount() const;
+};
+
+class HashAggregate {
+ private:
+  static constexpr int PARTITION_BITS = 6;
+  static constexpr int PARTITIONS = 1 << PARTITION_BITS;
+
+  int threads;
+
+ public:
+  // constructor, 0 threads means one per hardware thread
+  HashAggregate(int = 0);
+
+  std::vector<Group> run(const int*, const long long*, size_t) const;
+
+  int getThreads() const;
+};
+
+#endif
@@ -0,0 +1,937 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <list>
+#include <string>
+
+#include "Chaining.cpp"
+#include "CompactHashMap.hpp"
+#include "CuckooHashTable.cpp"
+#include "HashMap.hpp"
+#include "HashTable.cpp"
+#include "HopscotchHashTable.cpp"
+#include "LRUCache.hpp"
+#include "PerfectHashTable.cpp"
+#include "RobinHoodHashTable.cpp"
+#include "SwissTable.cpp"
+
+/*
+
+A small benchmark for the hash tables in this folder.
+
+Build it with optimizations turned on, for example:
+
+  g++ -std=c++17 -O2 HashBenchmark.cpp -o HashBenchmark
+
+Churn: the table is filled to 70%, then we keep removing a random key and adding
+a new one. After every round we time each lookup one by one and report the
+median (p50), the 99th percentile (p99) and the worst lookup. At the end, the
+statistics of the linear-probing table are printed; build with -DHASH_STATS to
+include the probe lengths (the counting makes every operation slower).
+
+Growth: a Chaining table starts with 16 buckets and we add keys until it has
+grown many times. Every add is timed, so the pause of a full rehash shows up as
+the worst add.
+
+Misses: the open-addressing tables are filled to a high load factor and we look
+up keys that are not there. The average time per lookup is reported. The cuckoo
+table always looks at two buckets, no matter how full it is, and the hopscotch
+table only at the slots its neighborhood bitmap points at.
+
+Allocations: every call to the global operator new is counted. Chaining takes
+its nodes from a NodePool, HashMap calls new for every node.
+
+Hostile keys: key sets that break "key % size" (multiples of a power of two,
+keys that only differ in their high bits, negative keys). We compare the longest
+chain of a map that uses the key itself as the hash with the seeded Chaining
+table, and time searches in the seeded HashTable.
+
+One bucket: a Chaining table that never grows, with one bucket for every key,
+the worst any hash function can do. The bucket becomes a tree, so the time per
+search grows with log n instead of n.
+
+Bloom filter: a Chaining table with and without the Bloom filter in front of
+its buckets, searching keys that are missing and keys that are there.
+
+Batches: tables much bigger than the cache, so that nearly every lookup misses
+it. We compare search one key at a time with searchBatch, and add with addBatch.
+For Chaining, one key at a time is find: like searchBatch it returns a pointer
+to the value, so only the prefetching makes the difference.
+
+Perfect hash: a fixed set of keys in a PerfectHashTable, a HashTable and a
+CuckooHashTable. We time the build (or all the adds) and searches for keys that
+are there and keys that are not. The perfect hash table looks at one slot only.
+
+Values: 64-character values (too long for the small string buffer, every copy
+allocates) added and looked up in Chaining. We count the calls to new and time
+add with a copy, add with std::move, emplace, search (which builds a message)
+and find (which returns a pointer).
+
+Compact map: 1M int keys with short string values in Chaining, HashMap and
+CompactHashMap. We report the memory of the full map (getBytes: the buckets or
+the index, the nodes or the entries; malloc adds a few more bytes to every
+HashMap node), and time adding every key, finding every key and walking every
+entry (Chaining has no walk).
+
+LRU cache: a cache of 64K entries in front of 1M keys, where 3 of 4 lookups go
+to a hot set of 32K keys. A miss puts the key into the cache. LRUCache keeps
+one pooled node per entry; the old way is a HashMap of list iterators next to a
+std::list, two allocations per new entry.
+
+*/
+
+using Clock = std::chrono::steady_clock;
+
+// counts every call to the global operator new in this program
+long long heapAllocations = 0;
+
+// GCC sees free() on memory from a replaced operator new once both are inlined
+// and warns about a mismatch (-Wmismatched-new-delete). Here the pair is
+// matched on purpose, so the warning is turned off for these three only
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t bytes) {
+  heapAllocations++;
+  if (void* memory = std::malloc(bytes)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+const int TABLE_SIZE = 1 << 14;
+const int LOOKUPS = 20000;
+
+// a tiny xorshift generator, so that every run uses the same keys
+struct Random {
+  unsigned long long state;
+
+  Random(unsigned long long seed) : state(seed) {}
+
+  unsigned long long next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+  int below(int bound) { return (int)(next() % bound); }
+};
+
+// multiplying by an odd number is a bijection modulo 2^30, so every counter
+// value gives a distinct, well spread, non-negative key
+int makeKey(int counter) { return (int)((counter * 2654435761u) & 0x3FFFFFFF); }
+
+struct Latency {
+  double p50;
+  double p99;
+  double max;
+};
+
+// sorts the samples and picks the percentiles
+Latency summarize(std::vector<double>& samples) {
+  std::sort(samples.begin(), samples.end());
+  Latency res;
+  res.p50 = samples[samples.size() / 2];
+  res.p99 = samples[samples.size() * 99 / 100];
+  res.max = samples.back();
+  return res;
+}
+
+// times every lookup and summarizes them in nanoseconds
+template <typename Table>
+Latency timeLookups(Table& table, const std::vector<int>& keys) {
+  std::vector<double> samples;
+  samples.reserve(keys.size());
+  volatile int sink = 0;
+
+  for (int key : keys) {
+    Clock::time_point start = Clock::now();
+    sink = sink + table.search(key);
+    Clock::time_point end = Clock::now();
+    samples.push_back(
+        std::chrono::duration<double, std::nano>(end - start).count());
+  }
+
+  return summarize(samples);
+}
+
+void printLatency(const std::string& name, const Latency& hit,
+                  const Latency& miss) {
+  cout << "  " << std::left << std::setw(12) << name << std::right
+       << std::fixed << std::setprecision(0) << "hit p50 " << std::setw(6)
+       << hit.p50 << "  p99 " << std::setw(6) << hit.p99 << "  max "
+       << std::setw(8) << hit.max << "   miss p50 " << std::setw(6) << miss.p50
+       << "  p99 " << std::setw(6) << miss.p99 << "  max " << std::setw(8)
+       << miss.max << "\n";
+}
+
+template <typename Table>
+void churnRound(Table& table, std::vector<int>& liveKeys, int& counter,
+                int rounds, Random& rng) {
+  for (int i = 0; i < rounds; i++) {
+    int pos = rng.below((int)liveKeys.size());
+    table.remove(liveKeys[pos]);
+    liveKeys[pos] = makeKey(counter++);
+    table.add(liveKeys[pos]);
+  }
+}
+
+void benchmarkChurn() {
+  cout << "\n==== Churn: linear probing vs Robin Hood (ns per lookup) ====\n";
+  cout << "table size " << TABLE_SIZE << ", load factor 0.70\n";
+
+  HashTable linear(TABLE_SIZE);
+  RobinHoodHashTable robinHood(TABLE_SIZE);
+
+  // both tables see exactly the same keys
+  std::vector<int> liveKeys;
+  int counter = 0;
+  while ((int)liveKeys.size() < TABLE_SIZE * 7 / 10) {
+    liveKeys.push_back(makeKey(counter++));
+    linear.add(liveKeys.back());
+    robinHood.add(liveKeys.back());
+  }
+
+  Random rng(2024);
+  int churned = 0;
+  const int steps[] = {0, TABLE_SIZE, 4 * TABLE_SIZE, 16 * TABLE_SIZE};
+
+  for (int step : steps) {
+    // replay the same removes and adds on both tables
+    std::vector<int> linearKeys = liveKeys;
+    int linearCounter = counter;
+    Random linearRng = rng;
+    churnRound(linear, linearKeys, linearCounter, step - churned, linearRng);
+    churnRound(robinHood, liveKeys, counter, step - churned, rng);
+    churned = step;
+
+    std::vector<int> hits, misses;
+    for (int i = 0; i < LOOKUPS; i++) {
+      hits.push_back(liveKeys[rng.below((int)liveKeys.size())]);
+      // keys that were never added
+      misses.push_back(makeKey(counter + 1 + i));
+    }
+
+    // the linear-probing table grows and cleans up its dirty slots by itself
+    cout << "\nafter " << step << " remove/add pairs (linear table size "
+         << linear.getSize() << "):\n";
+    printLatency("linear", timeLookups(linear, hits),
+                 timeLookups(linear, misses));
+    printLatency("robin hood", timeLookups(robinHood, hits),
+                 timeLookups(robinHood, misses));
+  }
+
+  cout << "\nlinear table after the churn:\n";
+  linear.printStats();
+}
+
+Latency timeChainingGrowth(int rehashStep, int keys) {
+  Chaining chaining(16, rehashStep);
+  std::vector<double> samples;
+  samples.reserve(keys);
+  std::string val = "value";
+
+  for (int i = 0; i < keys; i++) {
+    int key = makeKey(i);
+    Clock::time_point start = Clock::now();
+    chaining.add(key, val);
+    Clock::time_point end = Clock::now();
+    samples.push_back(
+        std::chrono::duration<double, std::nano>(end - start).count());
+  }
+
+  return summarize(samples);
+}
+
+void benchmarkChainingGrowth() {
+  const int keys = 1 << 20;
+  cout << "\n==== Growth: Chaining rehash all at once vs incremental ====\n";
+  cout << keys << " adds into a table that starts with 16 buckets\n\n";
+
+  const int steps[] = {REHASH_ALL, 1, 4};
+  for (int step : steps) {
+    Latency res = timeChainingGrowth(step, keys);
+    std::string name = step == REHASH_ALL ? "all at once"
+                                          : "step " + std::to_string(step);
+    cout << "  " << std::left << std::setw(12) << name << std::right
+         << std::fixed << std::setprecision(0) << "add p50 " << std::setw(6)
+         << res.p50 << "  p99 " << std::setw(6) << res.p99 << "  max "
+         << std::setw(10) << res.max << "\n";
+  }
+}
+
+// average nanoseconds per search over all the keys
+template <typename Table>
+double timeSearches(const Table& table, const std::vector<int>& keys) {
+  volatile int sink = 0;
+  Clock::time_point start = Clock::now();
+  for (int key : keys) {
+    sink = sink + const_cast<Table&>(table).search(key);
+  }
+  Clock::time_point end = Clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         keys.size();
+}
+
+void benchmarkMisses() {
+  const int size = 1 << 20;
+  const double loads[] = {0.5, 0.75, 0.85, 0.9};
+
+  cout << "\n==== Misses: linear probing vs Robin Hood vs Swiss vs cuckoo vs "
+          "hopscotch ====\n";
+  cout << "table size " << size << ", average ns per missing key\n\n";
+  cout << "  load     linear   robin hood   swiss   cuckoo   hopscotch\n";
+
+  for (double load : loads) {
+    // maxLoadFactor 0.9 keeps the linear table from growing during the fill
+    HashTable linear(size, 0.9, 0.25);
+    RobinHoodHashTable robinHood(size);
+    SwissTable swiss(size);
+    CuckooHashTable cuckoo(size);
+    HopscotchHashTable hopscotch(size, 0.95);
+
+    // random keys; makeKey would fill the low bits without a single collision
+    Random rng(7);
+    int keys = (int)(size * load);
+    for (int i = 0; i < keys; i++) {
+      int key = (int)(rng.next() & 0x3FFFFFFF);
+      linear.add(key);
+      robinHood.add(key);
+      swiss.add(key);
+      cuckoo.add(key);
+      hopscotch.add(key);
+    }
+
+    // the upper half of the key space was never used
+    std::vector<int> misses;
+    for (int i = 0; i < 1000000; i++) {
+      misses.push_back((int)(rng.next() & 0x3FFFFFFF) | 0x40000000);
+    }
+
+    cout << std::fixed << std::setprecision(2) << "  " << load << "   "
+         << std::setprecision(1) << std::setw(8) << timeSearches(linear, misses)
+         << std::setw(13) << timeSearches(robinHood, misses) << std::setw(8)
+         << timeSearches(swiss, misses) << std::setw(9)
+         << timeSearches(cuckoo, misses) << std::setw(12)
+         << timeSearches(hopscotch, misses)
+         << (hopscotch.getSize() != size ? " *" : "") << "\n";
+  }
+  cout << "\n  * the hopscotch table grew (H = 32: adds start to fail at about "
+          "85% full)\n";
+}
+
+// adds n keys, removes them all and adds them again, then destroys the table
+template <typename Table>
+void countAllocations(const std::string& name, int n) {
+  std::string val = "value";  // short enough to live inside std::string
+  Table* table = new Table(16);
+
+  long long before = heapAllocations;
+  for (int i = 0; i < n; i++) {
+    table->add(makeKey(i), val);
+  }
+  long long afterAdd = heapAllocations;
+  for (int i = 0; i < n; i++) {
+    table->remove(makeKey(i));
+  }
+  long long afterRemove = heapAllocations;
+  for (int i = 0; i < n; i++) {
+    table->add(makeKey(i), val);
+  }
+  long long afterReadd = heapAllocations;
+
+  Clock::time_point start = Clock::now();
+  delete table;
+  Clock::time_point end = Clock::now();
+
+  cout << "  " << std::left << std::setw(10) << name << std::right
+       << std::fixed << std::setprecision(3) << std::setw(12)
+       << (double)(afterAdd - before) / n << std::setw(12)
+       << (double)(afterRemove - afterAdd) / n << std::setw(12)
+       << (double)(afterReadd - afterRemove) / n << std::setprecision(1)
+       << std::setw(14)
+       << std::chrono::duration<double, std::milli>(end - start).count()
+       << "\n";
+}
+
+// gives HashMap the same add/remove interface as Chaining
+struct PlainMap {
+  HashMap<int, std::string> map;
+
+  PlainMap(int size) : map(size) {}
+
+  bool add(int key, const std::string& val) { return map.insert(key, val); }
+
+  bool remove(int key) { return map.remove(key); }
+};
+
+void benchmarkAllocations() {
+  const int n = 1 << 20;
+  cout << "\n==== Allocations: pooled Chaining vs new per node ====\n";
+  cout << n << " adds, then " << n << " removes and " << n << " adds\n\n";
+  // Chaining::remove builds its "... is removed" message on the heap
+  cout << "  table       new/add  new/remove  new/re-add   teardown ms\n";
+  countAllocations<Chaining>("Chaining", n);
+  countAllocations<PlainMap>("HashMap", n);
+}
+
+// the old behaviour: the key itself, masked to the number of buckets
+struct IdentityHash {
+  size_t operator()(uint64_t key) const { return (size_t)key; }
+};
+
+void benchmarkHostileKeys() {
+  const int n = 1 << 16;
+  const std::string names[] = {"sequential", "multiples of 1024",
+                               "multiples of 16384", "high bits only",
+                               "negative"};
+
+  cout << "\n==== Hostile keys: " << n << " keys, " << n
+       << " buckets ====\n\n";
+  cout << "  key set              identity chain   seeded chain   "
+          "HashTable ns/search\n";
+
+  for (int set = 0; set < 5; set++) {
+    std::vector<int> keys;
+    for (int i = 0; i < n; i++) {
+      switch (set) {
+        case 0: keys.push_back(i); break;
+        case 1: keys.push_back(i * 1024); break;
+        case 2: keys.push_back(i * 16384); break;
+        case 3: keys.push_back((i << 15) | 7); break;
+        default: keys.push_back(-3 - i); break;
+      }
+    }
+
+    HashMap<int, int, IdentityHash> identity(n);
+    Chaining seeded(n);
+    HashTable table(n);
+    for (int key : keys) {
+      identity.insert(key, 0);
+      seeded.add(key, "value");
+      table.add(key);
+    }
+
+    cout << "  " << std::left << std::setw(21) << names[set] << std::right
+         << std::setw(14) << identity.longestChain() << std::setw(15)
+         << seeded.getLongestChain() << std::fixed << std::setprecision(1)
+         << std::setw(22) << timeSearches(table, keys) << "\n";
+  }
+}
+
+void benchmarkOneBucket() {
+  cout << "\n==== One bucket: every key in the same tree bucket ====\n\n";
+  cout << "  keys     ns/search\n";
+
+  for (int n = 1000; n <= 1000000; n *= 10) {
+    // a huge maxLoadFactor keeps the single bucket from ever being split
+    Chaining table(1, REHASH_ALL, 1e12);
+    std::vector<int> keys;
+    for (int i = 0; i < n; i++) {
+      keys.push_back(makeKey(i));
+      table.add(keys.back(), "value");
+    }
+
+    Random rng(5);
+    std::vector<int> probes;
+    for (int i = 0; i < LOOKUPS; i++) {
+      probes.push_back(keys[rng.below(n)]);
+    }
+
+    volatile size_t sink = 0;
+    Clock::time_point start = Clock::now();
+    for (int key : probes) {
+      sink = sink + table.search(key).size();
+    }
+    cout << "  " << std::left << std::setw(9) << n << std::right << std::fixed
+         << std::setprecision(1) << std::setw(9)
+         << std::chrono::duration<double, std::nano>(Clock::now() - start)
+                    .count() /
+                probes.size()
+         << "\n";
+  }
+}
+
+void benchmarkBloomFilter() {
+  const int keys = 1 << 20;
+
+  cout << "\n==== Bloom filter: Chaining with and without the filter ====\n";
+  cout << keys << " keys, average ns per search\n\n";
+  cout << "  table          misses     hits\n";
+
+  std::vector<int> hits;
+  std::vector<int> misses;
+  for (int i = 0; i < LOOKUPS * 10; i++) {
+    hits.push_back(makeKey(i * 7 % keys));
+    misses.push_back(makeKey(keys + i));
+  }
+
+  for (int useFilter = 0; useFilter < 2; useFilter++) {
+    Chaining table(16, REHASH_ALL);
+    if (useFilter) {
+      table.enableFilter();
+    }
+    for (int i = 0; i < keys; i++) {
+      table.add(makeKey(i), "value");
+    }
+
+    volatile size_t sink = 0;
+    Clock::time_point start = Clock::now();
+    for (int key : misses) {
+      sink = sink + table.search(key).size();
+    }
+    double missTime =
+        std::chrono::duration<double, std::nano>(Clock::now() - start)
+            .count() /
+        misses.size();
+
+    start = Clock::now();
+    for (int key : hits) {
+      sink = sink + table.search(key).size();
+    }
+    double hitTime =
+        std::chrono::duration<double, std::nano>(Clock::now() - start)
+            .count() /
+        hits.size();
+
+    cout << "  " << (useFilter ? "with filter" : "no filter  ") << std::fixed
+         << std::setprecision(1) << std::setw(11) << missTime << std::setw(9)
+         << hitTime << "\n";
+  }
+}
+
+void benchmarkBatches() {
+  const int keys = 1 << 21;
+  const int lookups = 1 << 20;
+
+  Random rng(11);
+  std::vector<int> added;
+  for (int i = 0; i < keys; i++) {
+    added.push_back((int)(rng.next() & 0x3FFFFFFF));
+  }
+  // every lookup hits, in an order unrelated to the table layout
+  std::vector<int> probes;
+  for (int i = 0; i < lookups; i++) {
+    probes.push_back(added[rng.below(keys)]);
+  }
+  std::vector<std::string> vals(keys, "value");
+
+  cout << "\n==== Batches: one key at a time vs searchBatch / addBatch ====\n";
+  cout << keys << " keys, average ns per key\n\n";
+  cout << "  table          add   addBatch     search   searchBatch\n";
+  cout << "  (search is find for Chaining, a pointer to the value)\n";
+
+  volatile long long sink = 0;
+  auto nsPerKey = [](Clock::time_point start, int n) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start)
+               .count() /
+           n;
+  };
+
+  {
+    HashTable single(16);
+    HashTable batched(16);
+    std::vector<int> results(lookups);
+
+    Clock::time_point start = Clock::now();
+    for (int key : added) {
+      single.add(key);
+    }
+    double add = nsPerKey(start, keys);
+
+    start = Clock::now();
+    batched.addBatch(added.data(), keys);
+    double addBatch = nsPerKey(start, keys);
+
+    start = Clock::now();
+    for (int key : probes) {
+      sink = sink + single.search(key);
+    }
+    double search = nsPerKey(start, lookups);
+
+    start = Clock::now();
+    batched.searchBatch(probes.data(), lookups, results.data());
+    double searchBatch = nsPerKey(start, lookups);
+    sink = sink + results[0];
+
+    cout << std::fixed << std::setprecision(1) << "  HashTable" << std::setw(10)
+         << add << std::setw(11) << addBatch << std::setw(11) << search
+         << std::setw(14) << searchBatch << "\n";
+  }
+
+  {
+    Chaining single(16, REHASH_ALL);
+    Chaining batched(16, REHASH_ALL);
+    std::vector<const std::string*> results(lookups);
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < keys; i++) {
+      single.add(added[i], vals[i]);
+    }
+    double add = nsPerKey(start, keys);
+
+    start = Clock::now();
+    batched.addBatch(added.data(), vals.data(), keys);
+    double addBatch = nsPerKey(start, keys);
+
+    // find, not search: search also builds its "... is found" message, and
+    // the gap would mix the saved allocations with the prefetching. find and
+    // searchBatch both return a pointer to the value
+    start = Clock::now();
+    for (int key : probes) {
+      sink = sink + (long long)single.find(key)->size();
+    }
+    double search = nsPerKey(start, lookups);
+
+    start = Clock::now();
+    batched.searchBatch(probes.data(), lookups, results.data());
+    for (const std::string* val : results) {
+      sink = sink + (long long)val->size();
+    }
+    double searchBatch = nsPerKey(start, lookups);
+
+    cout << std::fixed << std::setprecision(1) << "  Chaining " << std::setw(10)
+         << add << std::setw(11) << addBatch << std::setw(11) << search
+         << std::setw(14) << searchBatch << "\n";
+  }
+}
+
+void benchmarkPerfectHash() {
+  const int keys = 1 << 20;
+  const int lookups = 1 << 20;
+
+  Random rng(13);
+  std::vector<int> added;
+  for (int i = 0; i < keys; i++) {
+    added.push_back(makeKey(i));
+  }
+  std::vector<int> hits;
+  std::vector<int> misses;
+  for (int i = 0; i < lookups; i++) {
+    hits.push_back(added[rng.below(keys)]);
+    misses.push_back(makeKey(keys + i));
+  }
+
+  cout << "\n==== Perfect hash: a fixed key set ====\n";
+  cout << keys << " keys, build in ms, average ns per search\n\n";
+  cout << "  table          build     hits   misses\n";
+
+  volatile long long sink = 0;
+  auto nsPerKey = [](Clock::time_point start, int n) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start)
+               .count() /
+           n;
+  };
+  auto print = [](const char* name, double build, double hit, double miss) {
+    cout << std::fixed << std::setprecision(1) << "  " << name << std::setw(9)
+         << build / 1e6 << std::setw(9) << hit << std::setw(9) << miss << "\n";
+  };
+
+  {
+    std::vector<std::string> vals(keys, "value");
+    Clock::time_point start = Clock::now();
+    PerfectHashTable table(added, vals);
+    double build = nsPerKey(start, 1);
+
+    start = Clock::now();
+    for (int key : hits) {
+      sink = sink + table.indexOf(key);
+    }
+    double hit = nsPerKey(start, lookups);
+
+    start = Clock::now();
+    for (int key : misses) {
+      sink = sink + table.indexOf(key);
+    }
+    print("perfect hash", build, hit, nsPerKey(start, lookups));
+  }
+
+  {
+    Clock::time_point start = Clock::now();
+    HashTable table(16);
+    for (int key : added) {
+      table.add(key);
+    }
+    double build = nsPerKey(start, 1);
+
+    start = Clock::now();
+    for (int key : hits) {
+      sink = sink + table.search(key);
+    }
+    double hit = nsPerKey(start, lookups);
+
+    start = Clock::now();
+    for (int key : misses) {
+      sink = sink + table.search(key);
+    }
+    print("linear      ", build, hit, nsPerKey(start, lookups));
+  }
+
+  {
+    Clock::time_point start = Clock::now();
+    CuckooHashTable table(16);
+    for (int key : added) {
+      table.add(key);
+    }
+    double build = nsPerKey(start, 1);
+
+    start = Clock::now();
+    for (int key : hits) {
+      sink = sink + table.search(key);
+    }
+    double hit = nsPerKey(start, lookups);
+
+    start = Clock::now();
+    for (int key : misses) {
+      sink = sink + table.search(key);
+    }
+    print("cuckoo      ", build, hit, nsPerKey(start, lookups));
+  }
+}
+
+void benchmarkValues() {
+  const int keys = 1 << 18;
+  const std::string value(64, 'v');
+
+  cout << "\n==== Values: copies of 64-character values in Chaining ====\n";
+  cout << keys << " keys, calls to new and ns per operation\n\n";
+  cout << "  operation              new/op    ns/op\n";
+
+  auto print = [](const char* name, long long allocations,
+                  Clock::time_point start, int n) {
+    cout << std::fixed << std::setprecision(2) << "  " << std::left
+         << std::setw(22) << name << std::right << std::setw(7)
+         << (double)allocations / n << std::setprecision(1) << std::setw(9)
+         << std::chrono::duration<double, std::nano>(Clock::now() - start)
+                    .count() /
+                n
+         << "\n";
+  };
+
+  {
+    Chaining table(keys, REHASH_ALL);
+    long long before = heapAllocations;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < keys; i++) {
+      table.add(makeKey(i), value);
+    }
+    print("add(key, value)", heapAllocations - before, start, keys);
+  }
+
+  {
+    Chaining table(keys, REHASH_ALL);
+    std::vector<std::string> values(keys, value);
+    long long before = heapAllocations;
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < keys; i++) {
+      table.add(makeKey(i), std::move(values[i]));
+    }
+    print("add(key, move(value))", heapAllocations - before, start, keys);
+  }
+
+  Chaining table(keys, REHASH_ALL);
+  long long before = heapAllocations;
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < keys; i++) {
+    table.emplace(makeKey(i), 64, 'v');
+  }
+  print("emplace(key, 64, 'v')", heapAllocations - before, start, keys);
+
+  volatile size_t sink = 0;
+  before = heapAllocations;
+  start = Clock::now();
+  for (int i = 0; i < keys; i++) {
+    sink = sink + table.search(makeKey(i)).size();
+  }
+  print("search(key)", heapAllocations - before, start, keys);
+
+  before = heapAllocations;
+  start = Clock::now();
+  for (int i = 0; i < keys; i++) {
+    sink = sink + table.find(makeKey(i))->size();
+  }
+  print("find(key)", heapAllocations - before, start, keys);
+}
+
+void benchmarkCompactMap() {
+  const int keys = 1 << 20;
+  const std::string value = "value";  // fits the small string buffer
+
+  cout << "\n==== Compact map: bytes per entry, ns per key ====\n";
+  cout << keys << " int keys, short string values\n\n";
+  cout << "  map              bytes/entry   add ns   find ns   walk ns\n";
+
+  auto nsPerKey = [keys](Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start)
+               .count() /
+           keys;
+  };
+  auto print = [keys](const char* name, size_t bytes, double add, double find,
+                      double walk) {
+    cout << std::fixed << std::setprecision(1) << "  " << std::left
+         << std::setw(16) << name << std::right << std::setw(12)
+         << (double)bytes / keys << std::setw(9) << add << std::setw(10)
+         << find << std::setw(10);
+    if (walk >= 0) {
+      cout << walk << "\n";
+    } else {
+      cout << "-" << "\n";
+    }
+  };
+  volatile size_t sink = 0;
+
+  {
+    Clock::time_point start = Clock::now();
+    Chaining table(16, REHASH_ALL);
+    for (int i = 0; i < keys; i++) {
+      table.add(makeKey(i), value);
+    }
+    double add = nsPerKey(start);
+
+    start = Clock::now();
+    for (int i = 0; i < keys; i++) {
+      sink = sink + table.find(makeKey(i))->size();
+    }
+    print("Chaining", table.getBytes(), add, nsPerKey(start), -1);
+  }
+
+  {
+    Clock::time_point start = Clock::now();
+    HashMap<int, std::string> map;
+    for (int i = 0; i < keys; i++) {
+      map.insert(makeKey(i), value);
+    }
+    double add = nsPerKey(start);
+
+    start = Clock::now();
+    for (int i = 0; i < keys; i++) {
+      sink = sink + map.find(makeKey(i))->size();
+    }
+    double find = nsPerKey(start);
+
+    start = Clock::now();
+    map.forEach([&sink](int, const std::string& val) {
+      sink = sink + val.size();
+    });
+    print("HashMap", map.getBytes(), add, find, nsPerKey(start));
+  }
+
+  Clock::time_point start = Clock::now();
+  CompactHashMap<int, std::string> map;
+  for (int i = 0; i < keys; i++) {
+    map.insert(makeKey(i), value);
+  }
+  double add = nsPerKey(start);
+
+  start = Clock::now();
+  for (int i = 0; i < keys; i++) {
+    sink = sink + map.find(makeKey(i))->size();
+  }
+  double find = nsPerKey(start);
+
+  start = Clock::now();
+  map.forEach([&sink](int, const std::string& val) {
+    sink = sink + val.size();
+  });
+  print("CompactHashMap", map.getBytes(), add, find, nsPerKey(start));
+}
+
+// the old way: a std::list in recency order and a HashMap from every key to its
+// place in the list
+class ListCache {
+ private:
+  using Entry = std::pair<int, std::string>;
+
+  std::list<Entry> entries;  // the most recently used first
+  HashMap<int, std::list<Entry>::iterator> index;
+  size_t capacity;
+
+ public:
+  ListCache(size_t maxEntries) : capacity(maxEntries) {}
+
+  std::string* get(int key) {
+    std::list<Entry>::iterator* place = index.find(key);
+    if (!place) {
+      return nullptr;
+    }
+    entries.splice(entries.begin(), entries, *place);
+    return &(*place)->second;
+  }
+
+  void put(int key, const std::string& val) {
+    entries.emplace_front(key, val);
+    index.insert(key, entries.begin());
+    if (entries.size() > capacity) {
+      index.remove(entries.back().first);
+      entries.pop_back();
+    }
+  }
+};
+
+template <typename Cache>
+void timeCache(const char* name) {
+  const int keys = 1 << 20;
+  const int hot = 1 << 15;
+  const int ops = 1 << 22;
+
+  Cache cache(1 << 16);
+  Random rng(17);
+  long long hits = 0;
+  long long allocationsBefore = heapAllocations;
+
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < ops; i++) {
+    int key = makeKey(rng.below(4) ? rng.below(hot) : rng.below(keys));
+    if (cache.get(key)) {
+      hits++;
+    } else {
+      cache.put(key, "value");
+    }
+  }
+  double ns =
+      std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+      ops;
+
+  cout << std::fixed << std::setprecision(1) << "  " << name << std::setw(9)
+       << ns << std::setw(12) << std::setprecision(3)
+       << (double)hits / ops << std::setw(15)
+       << (double)(heapAllocations - allocationsBefore) / (ops - hits) << "\n";
+}
+
+void benchmarkLRUCache() {
+  cout << "\n==== LRU cache: list + HashMap vs LRUCache ====\n";
+  cout << "64K entries, 1M keys, 3 of 4 lookups in a 32K hot set\n\n";
+  cout << "  cache          ns/op   hit ratio   new per miss\n";
+  timeCache<ListCache>("list + map");
+  timeCache<LRUCache<int, std::string>>("LRUCache  ");
+}
+
+int main() {
+  benchmarkChurn();
+  benchmarkChainingGrowth();
+  benchmarkMisses();
+  benchmarkAllocations();
+  benchmarkHostileKeys();
+  benchmarkOneBucket();
+  benchmarkBloomFilter();
+  benchmarkBatches();
+  benchmarkPerfectHash();
+  benchmarkValues();
+  benchmarkCompactMap();
+  benchmarkLRUCache();
+  cout << "\n";
+
+  return 0;
+}
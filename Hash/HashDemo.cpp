@@ -5,7 +5,9 @@ void printMenu();
 
 int main() {
   // declaration
-  HashTable hashTable(5);
+  // a fixed seed gives the same layout every run, leave it out to get a random
+  // one
+  HashTable hashTable(4, 0.75, 0.25, 2024);
   int num, res;
   bool isRunning = true;
 
@@ -14,7 +16,7 @@ int main() {
   cin >> num;
   while (num != -1) {
     if (!hashTable.add(num)) {
-      cout << "Error! Table is full!\n";
+      cout << "Error! " << num << " is already in the table!\n";
     }
     cin >> num;
   }
@@ -35,7 +37,7 @@ int main() {
         if (hashTable.add(num)) {
           cout << "\n...Added " << num << "\n";
         } else {
-          cout << "\n...Table is full! Stop adding.\n";
+          cout << "\n..." << num << " is already in the table!\n";
         }
         break;
       }
@@ -62,6 +64,8 @@ int main() {
       }
       case 4: {
         hashTable.printTable();
+        cout << "Size: " << hashTable.getSize()
+             << ", Load factor: " << hashTable.getLoadFactor() << "\n";
         break;
       }
       case 5: {
@@ -103,16 +107,22 @@ Enter numbers, -1 to stop:
 
 Initial Table:
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
+The table starts with 4 slots. Adding 4 would push the load factor to 1.0, so
+it grows to 8 slots first. The slots come from the seeded hash, not key & 7.
 
-Index 0: 5
-Index 1: 1
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  1  |  3  |  2  |  U  |  U  |  U  |  4  |  5  |
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+
+Index 0: 1
+Index 1: 3
 Index 2: 2
-Index 3: 3
-Index 4: 4
+Index 3: (Empty)
+Index 4: (Empty)
+Index 5: (Empty)
+Index 6: 4
+Index 7: 5
 
 **** Menu ****
 | 1. Add     |
@@ -123,14 +133,14 @@ Index 4: 4
 **************
 
 Enter your choice: 1
-Enter a number to add: 6
+Enter a number to add: 9
 
-...Table is full! Stop adding.
+...Added 9
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  1  |  3  |  2  |  U  |  9  |  U  |  4  |  5  |
+         +-----+-----+-----+-----+-----+-----+-----+-----+
 
 **** Menu ****
 | 1. Add     |
@@ -140,16 +150,10 @@ Enter a number to add: 6
 | 5. Exit    |
 **************
 
-Enter your choice: 2
-Enter a number to search: 2
-
-...Found 2 at index 2
+Enter your choice: 1
+Enter a number to add: 9
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-                        ^
+...9 is already in the table!
 
 **** Menu ****
 | 1. Add     |
@@ -160,14 +164,9 @@ Enter a number to search: 2
 **************
 
 Enter your choice: 2
-Enter a number to search: 6
-
-...Number 6 not found!
+Enter a number to search: 9
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
+...Found 9 at index 4
 
 **** Menu ****
 | 1. Add     |
@@ -182,10 +181,10 @@ Enter a number to delete: 2
 
 ...Number 2 is removed
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  D  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  1  |  3  |  D  |  U  |  9  |  U  |  4  |  5  |
+         +-----+-----+-----+-----+-----+-----+-----+-----+
 
 **** Menu ****
 | 1. Add     |
@@ -195,73 +194,30 @@ Enter a number to delete: 2
 | 5. Exit    |
 **************
 
-Enter your choice: 2
-Enter a number to search: 2
-
-...Number 2 not found!
-
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  D  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-                        ^
-
-**** Menu ****
-| 1. Add     |
-| 2. Lookup  |
-| 3. Remove  |
-| 4. Print   |
-| 5. Exit    |
-**************
-
-Enter your choice: 1
-Enter a number to add: 9
+Enter your choice: 4
+Index 0: 1
+Index 1: 3
+Index 2: (Dirty)
+Index 3: (Empty)
+Index 4: 9
+Index 5: (Empty)
+Index 6: 4
+Index 7: 5
+Size: 8, Load factor: 0.75
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  D  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-                                    ^
-
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  D  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-            ^
-
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  D  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-                  ^
-
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  D  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-                        ^
-
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  9  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
+...
 
-...Added 9
+(remove 3, 4, 5 and 1)
 
-**** Menu ****
-| 1. Add     |
-| 2. Lookup  |
-| 3. Remove  |
-| 4. Print   |
-| 5. Exit    |
-**************
+Only one key is left, 1 < 0.25 * 8, so the table shrinks back to 4 slots and
+the dirty slots are gone.
 
 Enter your choice: 4
-Index 0: 5
-Index 1: 1
-Index 2: 9
-Index 3: 3
-Index 4: 4
+Index 0: 9
+Index 1: (Empty)
+Index 2: (Empty)
+Index 3: (Empty)
+Size: 4, Load factor: 0.25
 
 **** Menu ****
 | 1. Add     |
@@ -275,10 +231,9 @@ Enter your choice: 5
 Exit the program...
 
 Final Table:
-Index 0: 5
-Index 1: 1
-Index 2: 9
-Index 3: 3
-Index 4: 4
+Index 0: 9
+Index 1: (Empty)
+Index 2: (Empty)
+Index 3: (Empty)
 
-*/
\ No newline at end of file
+*/
@@ -0,0 +1,531 @@
+#ifndef HASH_FUNCTIONS
+#define HASH_FUNCTIONS
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+
+/*
+
+Hash Functions as Policies:
+Each hash function below is a small struct with an operator(). A templated
+table (Check the HashMap.hpp) takes the struct as a template parameter, so the
+compiler knows exactly which function is called and can inline it. There is no
+function pointer and no virtual call.
+
+  HashMap<long long, std::string, MultiplicativeHash> map;
+                                  ^
+                      picked at compile time
+
+The table keeps a power-of-two number of buckets and uses the lowest bits of the
+hash value as the index, so a good hash function should spread the keys over the
+low bits.
+
+ +--------------------+---------------------------------------------------+
+ | Policy             | Idea                                              |
+ +--------------------+---------------------------------------------------+
+ | DivisionHash       | key % a large prime                               |
+ | ExtractionHash     | keep 32 bits from the middle of the key           |
+ | MidSquareHash      | square the key, keep the middle bits              |
+ | FoldingHash        | cut the key into 16-bit parts and add them up     |
+ | RadixHash          | write the key in base 11, read it in base 16      |
+ | MultiplicativeHash | key * (2^64 / golden ratio), keep the high bits   |
+ | MultiplyShiftHash  | (a * key + b) >> 32 with a random odd a           |
+ | Mix64Hash          | xor-shift-multiply mixer, every bit affects every |
+ |                    | other bit (default)                               |
+ | SeededHash         | SipHash-1-3 with a secret random seed per table   |
+ | WyHash             | wyhash: two 64x64 -> 128-bit multiplies per key   |
+ | XxHash             | XXH64: four lanes of multiply-rotate-multiply     |
+ +--------------------+---------------------------------------------------+
+
+The policies take 64-bit keys. Mix64Hash, SeededHash, WyHash and XxHash also
+take strings.
+
+The first five are the textbook functions (Check the end of HashTable.hpp).
+They are fast but weak: they leave the low bits of many key sets alike, and the
+table only uses the low bits. HashQualityBenchmark.cpp measures the speed and
+the quality of every policy on sequential, strided and random keys.
+
+*/
+
+// the finalizer of MurmurHash3: every input bit flips about half of the output
+// bits
+inline uint64_t mix64(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  key *= 0xc4ceb9fe1a85ec53ULL;
+  key ^= key >> 33;
+  return key;
+}
+
+// FNV-1a: xor in a byte, then multiply by a prime, for every byte
+inline uint64_t fnv1a64(const char* data, size_t length) {
+  uint64_t hashVal = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < length; i++) {
+    hashVal ^= (unsigned char)data[i];
+    hashVal *= 0x100000001b3ULL;
+  }
+  return hashVal;
+}
+
+// a fresh random seed from the operating system
+inline uint64_t randomSeed() {
+  std::random_device device;
+  return ((uint64_t)device() << 32) ^ device();
+}
+
+/*
+
+Division:
+  hashVal = key % 4294967291 (the largest prime below 2^32)
+
+  123456789 % 4294967291 = 123456789
+
+A prime divisor keeps keys with a common factor (10, 20, 30, ...) apart.
+
+*/
+struct DivisionHash {
+  size_t operator()(uint64_t key) const { return key % 4294967291ULL; }
+};
+
+/*
+
+Extraction:
+  Keep a part of the key: bits 16 to 47
+
+  123456789 = 0x75bcd15 --> (0x75bcd15 >> 16) & 0xffffffff = 0x75b = 1883
+
+Cheap, but every bit outside the part is ignored: keys that only differ in
+their lowest 16 bits (0, 1, 2, ...) all get the same hash value.
+
+*/
+struct ExtractionHash {
+  size_t operator()(uint64_t key) const {
+    return (size_t)((key >> 16) & 0xffffffffULL);
+  }
+};
+
+/*
+
+Mid-Square:
+  123456789 * 123456789 = 15241578750190521
+  Keep the middle bits: (key * key) >> 16, lower 32 bits
+
+The middle of the square depends on every digit of the key.
+
+*/
+struct MidSquareHash {
+  size_t operator()(uint64_t key) const {
+    return (size_t)((key * key) >> 16) & 0xffffffffULL;
+  }
+};
+
+/*
+
+Shift Folding:
+  Cut the 64-bit key into four 16-bit parts and add them up.
+
+  +--------+--------+--------+--------+
+  | part 3 | part 2 | part 1 | part 0 |  --> part 0 + part 1 + part 2 + part 3
+  +--------+--------+--------+--------+
+
+*/
+struct FoldingHash {
+  size_t operator()(uint64_t key) const {
+    return (key & 0xffff) + ((key >> 16) & 0xffff) + ((key >> 32) & 0xffff) +
+           (key >> 48);
+  }
+};
+
+/*
+
+Radix Transformation:
+  Write the key in base 11 and read the digits as a base 16 number.
+
+  123456789 = 63762A05 (base 11) --> 0x63762a05 = 1668688389
+
+A digit of base 11 is never above 10 (0xa), so digits b to f never appear. The
+digits of the two bases do not line up, so nearby keys end up far apart. It
+costs a division per digit.
+
+*/
+struct RadixHash {
+  size_t operator()(uint64_t key) const {
+    uint64_t hashVal = 0;
+    uint64_t place = 1;
+    while (key > 0) {
+      hashVal += (key % 11) * place;
+      key /= 11;
+      place <<= 4;
+    }
+    return (size_t)hashVal;
+  }
+};
+
+/*
+
+Multiplicative (Knuth):
+  hashVal = (key * 11400714819323198485) >> 32
+
+11400714819323198485 is 2^64 divided by the golden ratio. The multiplication
+pushes the information of the key towards the high bits, so we keep those.
+
+*/
+struct MultiplicativeHash {
+  size_t operator()(uint64_t key) const {
+    return (size_t)((key * 11400714819323198485ULL) >> 32);
+  }
+};
+
+/*
+
+Multiply-Add-Shift (Dietzfelbinger):
+  hashVal = (a * key + b) >> 32, a random odd a and a random b
+
+Like the multiplicative hash, but a and b are drawn for every table, so no key
+set is bad for every table. For two different keys, the chance that their
+hashes collide is about 2 / 2^32 over the choice of a and b.
+
+*/
+struct MultiplyShiftHash {
+  uint64_t a;
+  uint64_t b;
+
+  MultiplyShiftHash() : MultiplyShiftHash(randomSeed()) {}
+  MultiplyShiftHash(uint64_t seed) : a(mix64(seed) | 1), b(mix64(~seed)) {}
+
+  size_t operator()(uint64_t key) const {
+    return (size_t)((a * key + b) >> 32);
+  }
+};
+
+// the default policy: fast and good at spreading both integers and strings
+struct Mix64Hash {
+  size_t operator()(uint64_t key) const { return (size_t)mix64(key); }
+
+  size_t operator()(const std::string& key) const {
+    return (size_t)mix64(fnv1a64(key.data(), key.size()));
+  }
+};
+
+/*
+
+Seeded Hashing:
+Every function above is fixed. Anyone who knows the function can pick keys that
+all land in the same bucket, for example multiples of the table size with
+division:
+
+  8 % 8 = 0, 16 % 8 = 0, 24 % 8 = 0, ...  --> one long chain, O(n) lookups
+
+A seeded hash mixes a secret random number into every key. Each table draws its
+own seed when it is created, so a key set that collides in one table (or one
+run of the program) is spread out in the next, and the attacker cannot compute
+it from outside.
+
+SipHash is a keyed hash built for exactly this job: it takes a 128-bit key
+(k0, k1) and the input, and every output bit depends on every input bit and
+every key bit. SipHash-1-3 does one round per 8-byte block and three at the end.
+
+Every seeded table holds a SeededHash (below). It draws one 64-bit seed and
+expands it to the 128-bit key: k0 is the seed and k1 is mix64(seed). So the
+key holds 64 bits of secret, not 128: plenty against keys chosen to collide,
+and one number to save or print to get the same layout again.
+
+*/
+
+inline uint64_t rotl64(uint64_t x, int b) {
+  return (x << b) | (x >> (64 - b));
+}
+
+inline void sipRound(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) {
+  v0 += v1;
+  v1 = rotl64(v1, 13);
+  v1 ^= v0;
+  v0 = rotl64(v0, 32);
+  v2 += v3;
+  v3 = rotl64(v3, 16);
+  v3 ^= v2;
+  v0 += v3;
+  v3 = rotl64(v3, 21);
+  v3 ^= v0;
+  v2 += v1;
+  v1 = rotl64(v1, 17);
+  v1 ^= v2;
+  v2 = rotl64(v2, 32);
+}
+
+// SipHash-1-3 of length bytes (blocks are read in the byte order of the
+// machine, which is little-endian on the usual x86 and ARM targets)
+inline uint64_t sipHash13(const char* data, size_t length, uint64_t k0,
+                          uint64_t k1) {
+  uint64_t v0 = k0 ^ 0x736f6d6570736575ULL;
+  uint64_t v1 = k1 ^ 0x646f72616e646f6dULL;
+  uint64_t v2 = k0 ^ 0x6c7967656e657261ULL;
+  uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+
+  size_t blocks = length / 8;
+  for (size_t i = 0; i < blocks; i++) {
+    uint64_t m;
+    std::memcpy(&m, data + i * 8, 8);
+    v3 ^= m;
+    sipRound(v0, v1, v2, v3);
+    v0 ^= m;
+  }
+
+  // the last block holds the leftover bytes and the length
+  uint64_t last = (uint64_t)length << 56;
+  for (size_t i = 0; i < length % 8; i++) {
+    last |= (uint64_t)(unsigned char)data[blocks * 8 + i] << (8 * i);
+  }
+  v3 ^= last;
+  sipRound(v0, v1, v2, v3);
+  v0 ^= last;
+
+  v2 ^= 0xff;
+  sipRound(v0, v1, v2, v3);
+  sipRound(v0, v1, v2, v3);
+  sipRound(v0, v1, v2, v3);
+  return v0 ^ v1 ^ v2 ^ v3;
+}
+
+inline uint64_t sipHash13(uint64_t key, uint64_t k0, uint64_t k1) {
+  return sipHash13((const char*)&key, 8, k0, k1);
+}
+
+struct SeededHash {
+  uint64_t k0;
+  uint64_t k1;
+
+  // every table gets its own random seed, unless a seed is given (for tests
+  // and demos that need the same layout every run)
+  SeededHash() : SeededHash(randomSeed()) {}
+  SeededHash(uint64_t seed) : k0(seed), k1(mix64(seed)) {}
+
+  size_t operator()(uint64_t key) const {
+    return (size_t)sipHash13(key, k0, k1);
+  }
+
+  size_t operator()(const std::string& key) const {
+    return (size_t)sipHash13(key.data(), key.size(), k0, k1);
+  }
+};
+
+/*
+
+wyhash and xxHash:
+Two fast hashes for strings and integers that pass the usual quality tests.
+Both take a 64-bit seed.
+
+ * wyhash reads 16 bytes at a time and mixes them with a 64 x 64 -> 128-bit
+   multiply, then xors the two halves of the product. An 8-byte key costs two
+   such multiplies
+ * XXH64 keeps four 64-bit lanes and feeds each one 8 bytes at a time: add
+   input * prime, rotate, multiply by a prime. The four lanes do not depend on
+   each other, so the CPU works on them in parallel. The end mixes every bit
+   of the state into every bit of the result (the avalanche)
+
+Neither is built to resist an attacker who can see the outputs, as SipHash is.
+
+*/
+
+// a * b as 128 bits, lo and hi are replaced by the two halves
+inline void mul128(uint64_t& lo, uint64_t& hi) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t product = (__uint128_t)lo * hi;
+  lo = (uint64_t)product;
+  hi = (uint64_t)(product >> 64);
+#else
+  // four 32 x 32 -> 64-bit products
+  uint64_t a = lo, b = hi;
+  uint64_t aLo = a & 0xffffffff, aHi = a >> 32;
+  uint64_t bLo = b & 0xffffffff, bHi = b >> 32;
+  uint64_t low = aLo * bLo, mid1 = aHi * bLo, mid2 = aLo * bHi;
+  uint64_t high = aHi * bHi;
+  uint64_t carry =
+      ((low >> 32) + (mid1 & 0xffffffff) + (mid2 & 0xffffffff)) >> 32;
+  lo = a * b;
+  hi = high + (mid1 >> 32) + (mid2 >> 32) + carry;
+#endif
+}
+
+inline uint64_t wyMix(uint64_t a, uint64_t b) {
+  mul128(a, b);
+  return a ^ b;
+}
+
+inline uint64_t read64(const char* data) {
+  uint64_t value;
+  std::memcpy(&value, data, 8);
+  return value;
+}
+
+inline uint64_t read32(const char* data) {
+  uint32_t value;
+  std::memcpy(&value, data, 4);
+  return value;
+}
+
+// wyhash (final version 4) with its default secret
+inline uint64_t wyHash(const char* data, size_t length, uint64_t seed) {
+  const uint64_t secret[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                              0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+  const unsigned char* bytes = (const unsigned char*)data;
+  seed ^= wyMix(seed ^ secret[0], secret[1]);
+  uint64_t a, b;
+
+  if (length <= 16) {
+    if (length >= 4) {
+      size_t shift = (length >> 3) << 2;
+      a = (read32(data) << 32) | read32(data + shift);
+      b = (read32(data + length - 4) << 32) | read32(data + length - 4 - shift);
+    } else if (length > 0) {
+      // the first, the middle and the last byte
+      a = ((uint64_t)bytes[0] << 16) | ((uint64_t)bytes[length >> 1] << 8) |
+          bytes[length - 1];
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = length;
+    if (i > 48) {
+      // three independent chains of 16 bytes each
+      uint64_t seed1 = seed, seed2 = seed;
+      do {
+        seed = wyMix(read64(data) ^ secret[1], read64(data + 8) ^ seed);
+        seed1 = wyMix(read64(data + 16) ^ secret[2], read64(data + 24) ^ seed1);
+        seed2 = wyMix(read64(data + 32) ^ secret[3], read64(data + 40) ^ seed2);
+        data += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (i > 16) {
+      seed = wyMix(read64(data) ^ secret[1], read64(data + 8) ^ seed);
+      data += 16;
+      i -= 16;
+    }
+    // the last 16 bytes, they may overlap bytes that were mixed already
+    a = read64(data + i - 16);
+    b = read64(data + i - 8);
+  }
+
+  a ^= secret[1];
+  b ^= seed;
+  mul128(a, b);
+  return wyMix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+const uint64_t XXH_PRIME1 = 0x9e3779b185ebca87ULL;
+const uint64_t XXH_PRIME2 = 0xc2b2ae3d27d4eb4fULL;
+const uint64_t XXH_PRIME3 = 0x165667b19e3779f9ULL;
+const uint64_t XXH_PRIME4 = 0x85ebca77c2b2ae63ULL;
+const uint64_t XXH_PRIME5 = 0x27d4eb2f165667c5ULL;
+
+inline uint64_t xxhRound(uint64_t lane, uint64_t input) {
+  lane += input * XXH_PRIME2;
+  lane = rotl64(lane, 31);
+  return lane * XXH_PRIME1;
+}
+
+inline uint64_t xxhMerge(uint64_t hashVal, uint64_t lane) {
+  hashVal ^= xxhRound(0, lane);
+  return hashVal * XXH_PRIME1 + XXH_PRIME4;
+}
+
+// XXH64
+inline uint64_t xxHash64(const char* data, size_t length, uint64_t seed) {
+  const char* end = data + length;
+  uint64_t hashVal;
+
+  if (length >= 32) {
+    uint64_t v1 = seed + XXH_PRIME1 + XXH_PRIME2;
+    uint64_t v2 = seed + XXH_PRIME2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - XXH_PRIME1;
+    do {
+      v1 = xxhRound(v1, read64(data));
+      v2 = xxhRound(v2, read64(data + 8));
+      v3 = xxhRound(v3, read64(data + 16));
+      v4 = xxhRound(v4, read64(data + 24));
+      data += 32;
+    } while (end - data >= 32);
+
+    hashVal = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+    hashVal = xxhMerge(hashVal, v1);
+    hashVal = xxhMerge(hashVal, v2);
+    hashVal = xxhMerge(hashVal, v3);
+    hashVal = xxhMerge(hashVal, v4);
+  } else {
+    hashVal = seed + XXH_PRIME5;
+  }
+  hashVal += length;
+
+  // the leftover bytes: 8, then 4, then 1 at a time
+  while (end - data >= 8) {
+    hashVal ^= xxhRound(0, read64(data));
+    hashVal = rotl64(hashVal, 27) * XXH_PRIME1 + XXH_PRIME4;
+    data += 8;
+  }
+  if (end - data >= 4) {
+    hashVal ^= read32(data) * XXH_PRIME1;
+    hashVal = rotl64(hashVal, 23) * XXH_PRIME2 + XXH_PRIME3;
+    data += 4;
+  }
+  while (data < end) {
+    hashVal ^= (unsigned char)*data * XXH_PRIME5;
+    hashVal = rotl64(hashVal, 11) * XXH_PRIME1;
+    data++;
+  }
+
+  // the avalanche
+  hashVal ^= hashVal >> 33;
+  hashVal *= XXH_PRIME2;
+  hashVal ^= hashVal >> 29;
+  hashVal *= XXH_PRIME3;
+  hashVal ^= hashVal >> 32;
+  return hashVal;
+}
+
+struct WyHash {
+  uint64_t seed;
+
+  WyHash(uint64_t s = 0) : seed(s) {}
+
+  size_t operator()(uint64_t key) const {
+    return (size_t)wyHash((const char*)&key, 8, seed);
+  }
+
+  size_t operator()(const std::string& key) const {
+    return (size_t)wyHash(key.data(), key.size(), seed);
+  }
+};
+
+struct XxHash {
+  uint64_t seed;
+
+  XxHash(uint64_t s = 0) : seed(s) {}
+
+  size_t operator()(uint64_t key) const {
+    return (size_t)xxHash64((const char*)&key, 8, seed);
+  }
+
+  size_t operator()(const std::string& key) const {
+    return (size_t)xxHash64(key.data(), key.size(), seed);
+  }
+};
+
+// asks the CPU to start loading the cache line of the address, without waiting
+// for it (Check the batched searches in HashTable.cpp and Chaining.cpp)
+inline void prefetch(const void* address) {
+#if defined(__GNUC__)
+  __builtin_prefetch(address);
+#else
+  (void)address;
+#endif
+}
+
+#endif
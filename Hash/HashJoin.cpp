@@ -0,0 +1,252 @@
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#include "HashJoin.hpp"
+
+// runs f(t) for t = 0 .. workers - 1 at the same time, the calling thread
+// runs f(0)
+template <typename F>
+static void runOnThreads(int workers, F f) {
+  std::vector<std::thread> pool;
+  for (int t = 1; t < workers; t++) {
+    pool.emplace_back(f, t);
+  }
+  f(0);
+  for (std::thread& worker : pool) {
+    worker.join();
+  }
+}
+
+JoinTable::JoinTable(size_t rows) {
+  slots.assign(slotsFor(rows), Slot{0, 0, false});
+}
+
+// a power of two, at least twice the rows
+size_t JoinTable::slotsFor(size_t rows) {
+  size_t size = 16;
+  while (size < rows * 2) {
+    size *= 2;
+  }
+  return size;
+}
+
+size_t JoinTable::bytesFor(size_t rows) {
+  return slotsFor(rows) * sizeof(Slot);
+}
+
+// a key that is already there is added again, every row counts
+void JoinTable::add(int key, int payload, uint64_t hashVal) {
+  size_t mask = slots.size() - 1;
+  size_t index = hashVal & mask;
+  while (slots[index].used) {
+    index = (index + 1) & mask;
+  }
+  slots[index] = Slot{key, payload, true};
+}
+
+void JoinTable::prefetchSlot(uint64_t hashVal) const {
+  prefetch(&slots[hashVal & (slots.size() - 1)]);
+}
+
+size_t JoinTable::getBytes() const { return slots.size() * sizeof(Slot); }
+
+HashJoin::HashJoin(int threadCount, int bits)
+    : threads(threadCount), partitionBits(bits) {
+  if (threads <= 0) {
+    threads = (int)std::thread::hardware_concurrency();
+  }
+  if (threads <= 0) {
+    threads = 1;
+  }
+  if (partitionBits < L2_PARTITIONS) {
+    throw std::invalid_argument(
+        "Error! The partition bits must be 0 or more, or L2_PARTITIONS.\n");
+  }
+  if (partitionBits > MAX_PARTITION_BITS) {
+    partitionBits = MAX_PARTITION_BITS;
+  }
+}
+
+int HashJoin::getThreads() const { return threads; }
+
+// the number of partition bits that puts every table in the L2 cache, 0 if
+// one table already fits
+int HashJoin::bitsFor(size_t buildRows) const {
+  size_t tableBytes = JoinTable::bytesFor(buildRows);
+  if (tableBytes <= L2_BYTES) {
+    return 0;
+  }
+
+  int bits = 0;
+  while (bits < MAX_PARTITION_BITS && (tableBytes >> bits) > L2_BYTES) {
+    bits++;
+  }
+  // a few partitions per thread, so that no thread waits for a slow one
+  while (bits < MAX_PARTITION_BITS && (1 << bits) < 4 * threads) {
+    bits++;
+  }
+  return bits;
+}
+
+// every pair of a left row and a right row with the same key, in no particular
+// order
+std::vector<JoinPair> HashJoin::run(const std::vector<Row>& left,
+                                    const std::vector<Row>& right) const {
+  // build on the smaller input, the table is smaller and probing is cheap
+  bool leftBuilds = left.size() <= right.size();
+  const std::vector<Row>& build = leftBuilds ? left : right;
+  const std::vector<Row>& probe = leftBuilds ? right : left;
+
+  int bits =
+      partitionBits == L2_PARTITIONS ? bitsFor(build.size()) : partitionBits;
+
+  // every thread writes its pairs to its own vector
+  std::vector<std::vector<JoinPair>> outputs(threads);
+  if (bits == NO_PARTITIONS) {
+    joinShared(build, probe, leftBuilds, outputs);
+  } else {
+    joinPartitioned(build, probe, leftBuilds, bits, outputs);
+  }
+
+  size_t total = 0;
+  for (const std::vector<JoinPair>& output : outputs) {
+    total += output.size();
+  }
+  std::vector<JoinPair> pairs;
+  pairs.reserve(total);
+  for (const std::vector<JoinPair>& output : outputs) {
+    pairs.insert(pairs.end(), output.begin(), output.end());
+  }
+  return pairs;
+}
+
+// leftBuilds tells which input the build rows came from, so the payloads go to
+// the right side of every pair
+void HashJoin::joinShared(const std::vector<Row>& build,
+                          const std::vector<Row>& probe, bool leftBuilds,
+                          std::vector<std::vector<JoinPair>>& outputs) const {
+  JoinTable table(build.size());
+  for (const Row& row : build) {
+    table.add(row.key, row.payload, mix64((uint64_t)row.key));
+  }
+
+  // the table is only read from now on, so the threads share it freely
+  const size_t ahead = 8;
+  runOnThreads(threads, [&](int t) {
+    size_t begin = probe.size() * t / threads;
+    size_t end = probe.size() * (t + 1) / threads;
+    std::vector<JoinPair>& output = outputs[t];
+
+    for (size_t i = begin; i < end; i++) {
+      // start loading the slot of a row a few rows ahead (Check the batched
+      // searches in HashTable.cpp)
+      if (i + ahead < end) {
+        table.prefetchSlot(mix64((uint64_t)probe[i + ahead].key));
+      }
+
+      const Row& row = probe[i];
+      table.probe(row.key, mix64((uint64_t)row.key), [&](int payload) {
+        output.push_back(leftBuilds ? JoinPair{row.key, payload, row.payload}
+                                    : JoinPair{row.key, row.payload, payload});
+      });
+    }
+  });
+}
+
+// copies the rows into out, grouped by partition. Partition p is
+// out[starts[p] .. starts[p + 1] - 1]
+void HashJoin::partition(const std::vector<Row>& rows, int bits,
+                         std::vector<Row>& out,
+                         std::vector<size_t>& starts) const {
+  int parts = 1 << bits;
+
+  // counts[t][p]: rows of thread t's slice in partition p
+  std::vector<std::vector<size_t>> counts(threads,
+                                          std::vector<size_t>(parts, 0));
+  runOnThreads(threads, [&](int t) {
+    size_t begin = rows.size() * t / threads;
+    size_t end = rows.size() * (t + 1) / threads;
+    for (size_t i = begin; i < end; i++) {
+      counts[t][mix64((uint64_t)rows[i].key) >> (64 - bits)]++;
+    }
+  });
+
+  // turn the counts into the place where every thread writes, partition by
+  // partition, thread by thread
+  starts.assign(parts + 1, 0);
+  size_t offset = 0;
+  for (int p = 0; p < parts; p++) {
+    starts[p] = offset;
+    for (int t = 0; t < threads; t++) {
+      size_t rowsHere = counts[t][p];
+      counts[t][p] = offset;
+      offset += rowsHere;
+    }
+  }
+  starts[parts] = offset;
+
+  out.resize(rows.size());
+  runOnThreads(threads, [&](int t) {
+    size_t begin = rows.size() * t / threads;
+    size_t end = rows.size() * (t + 1) / threads;
+    std::vector<size_t>& next = counts[t];
+    for (size_t i = begin; i < end; i++) {
+      out[next[mix64((uint64_t)rows[i].key) >> (64 - bits)]++] = rows[i];
+    }
+  });
+}
+/*
+
+Two threads, two partitions, the partition of a key is shown in brackets:
+
+  rows      thread 0: 1[0] 2[1] 3[0]     thread 1: 4[1] 5[0]
+
+  counts    thread 0: p0 2, p1 1         thread 1: p0 1, p1 1
+  offsets   thread 0: p0 0, p1 3         thread 1: p0 2, p1 4
+
+                 p0           p1
+            +---+---+---+ +---+---+
+  out       | 1 | 3 | 5 | | 2 | 4 |      starts: 0, 3, 5
+            +---+---+---+ +---+---+
+             t0  t0  t1    t0  t1
+
+Every thread writes to its own places, so no two threads write to the same
+row.
+
+*/
+
+void HashJoin::joinPartitioned(
+    const std::vector<Row>& build, const std::vector<Row>& probe,
+    bool leftBuilds, int bits,
+    std::vector<std::vector<JoinPair>>& outputs) const {
+  std::vector<Row> buildParts, probeParts;
+  std::vector<size_t> buildStarts, probeStarts;
+  partition(build, bits, buildParts, buildStarts);
+  partition(probe, bits, probeParts, probeStarts);
+
+  // every thread takes the next partition that nobody has joined yet
+  std::atomic<int> next(0);
+  runOnThreads(threads, [&](int t) {
+    std::vector<JoinPair>& output = outputs[t];
+    int p;
+
+    while ((p = next++) < (1 << bits)) {
+      JoinTable table(buildStarts[p + 1] - buildStarts[p]);
+      for (size_t i = buildStarts[p]; i < buildStarts[p + 1]; i++) {
+        const Row& row = buildParts[i];
+        table.add(row.key, row.payload, mix64((uint64_t)row.key));
+      }
+
+      // the table is in the cache now, no need to prefetch
+      for (size_t i = probeStarts[p]; i < probeStarts[p + 1]; i++) {
+        const Row& row = probeParts[i];
+        table.probe(row.key, mix64((uint64_t)row.key), [&](int payload) {
+          output.push_back(leftBuilds
+                               ? JoinPair{row.key, payload, row.payload}
+                               : JoinPair{row.key, row.payload, payload});
+        });
+      }
+    }
+  });
+}
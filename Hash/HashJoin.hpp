@@ -0,0 +1,142 @@
+#ifndef HASH_JOIN
+#define HASH_JOIN
+
+#include <cstdint>
+#include <iostream>  // preprocessor directive
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+A Hash Join finds every pair of rows, one from each input, that have the same
+key:
+
+  left  (key, payload)     right (key, payload)       result (key, left, right)
+  (1, 10)                  (2, 200)                   (2, 20, 200)
+  (2, 20)                  (1, 100)         --->      (1, 10, 100)
+  (3, 30)                  (2, 201)                   (2, 20, 201)
+                           (4, 400)
+
+1. Build: put every row of the smaller input into a hash table
+2. Probe: look up the key of every row of the larger input, every row of the
+   table with the same key makes a pair
+
+The table is open addressing with linear probing (Check the HashTable.hpp),
+with room for twice the rows so the clusters stay short. A key may appear many
+times, so a probe walks the whole cluster and does not stop at the first match.
+
+Two ways to run it on many threads:
+
+1. One shared table (NO_PARTITIONS): one thread builds the table, then every
+   thread probes a slice of the larger input. The table is only read during
+   the probe, so nobody takes a lock. When the table is bigger than the cache,
+   nearly every probe misses the cache.
+
+2. Radix partitioned (L2_PARTITIONS, or any number of bits): first, both
+   inputs are split into 2^bits partitions by the highest bits of the hash of
+   the key. A key lands in the same partition on both sides, so partition p of
+   the left only joins with partition p of the right. Then every thread takes
+   the next partition, builds a small table for it and probes it. With enough
+   partitions, every table fits in the L2 cache of its thread.
+
+  left   --> [p0 | p1 | p2 | p3]        thread A: build p0, probe p0
+  right  --> [p0 | p1 | p2 | p3]        thread B: build p1, probe p1 ...
+
+   The split itself runs in parallel: every thread counts the rows of its
+   slice per partition, the counts give every thread its own place in every
+   partition, and then every thread copies its rows there.
+
+ Time Complexity: O((m + n) / T + result) with T threads
+
+ Space complexity: O(m) for the table, O(m + n) more when partitioned
+
+*/
+
+struct Row {
+  int key;
+  int payload;
+};
+
+// a pair of rows with the same key
+struct JoinPair {
+  int key;
+  int left;   // payload of the left row
+  int right;  // payload of the right row
+};
+
+// one table, no split
+const int NO_PARTITIONS = 0;
+// as many partitions as needed for every table to fit in the L2 cache
+const int L2_PARTITIONS = -1;
+
+// build once, probe many times. Keys may repeat
+class JoinTable {
+ private:
+  struct Slot {
+    int key;
+    int payload;
+    bool used;
+  };
+
+  std::vector<Slot> slots;  // always a power of two
+
+  static size_t slotsFor(size_t);
+
+ public:
+  // constructor, room for the number of rows at a load factor of 0.5 or less
+  JoinTable(size_t = 0);
+
+  // the bytes of a table for the number of rows, without building it
+  static size_t bytesFor(size_t);
+
+  void add(int, int, uint64_t);
+  void prefetchSlot(uint64_t) const;
+
+  // calls f(payload) for every row of the key, hashVal is mix64 of the key
+  template <typename F>
+  void probe(int key, uint64_t hashVal, F f) const {
+    size_t mask = slots.size() - 1;
+    size_t index = hashVal & mask;
+    while (slots[index].used) {
+      if (slots[index].key == key) {
+        f(slots[index].payload);
+      }
+      index = (index + 1) & mask;
+    }
+  }
+
+  size_t getBytes() const;
+};
+
+class HashJoin {
+ private:
+  static constexpr size_t L2_BYTES = 256 * 1024;
+  static constexpr int MAX_PARTITION_BITS = 14;
+
+  int threads;
+  int partitionBits;
+
+  int bitsFor(size_t) const;
+  void joinShared(const std::vector<Row>&, const std::vector<Row>&, bool,
+                  std::vector<std::vector<JoinPair>>&) const;
+  void joinPartitioned(const std::vector<Row>&, const std::vector<Row>&, bool,
+                       int, std::vector<std::vector<JoinPair>>&) const;
+  void partition(const std::vector<Row>&, int, std::vector<Row>&,
+                 std::vector<size_t>&) const;
+
+ public:
+  // constructor, 0 threads means one per hardware thread. The partition bits
+  // are NO_PARTITIONS (0), a number of bits, or L2_PARTITIONS (-1)
+  HashJoin(int = 0, int = L2_PARTITIONS);
+
+  std::vector<JoinPair> run(const std::vector<Row>&,
+                            const std::vector<Row>&) const;
+
+  int getThreads() const;
+};
+
+#endif
@@ -0,0 +1,257 @@
+#ifndef HASH_MAP
+#define HASH_MAP
+
+#include <functional>
+#include <iostream>  // preprocessor directive
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+HashMap is a templated version of the Chaining table (Check the Chaining.hpp).
+Chaining only maps int keys to std::string values. HashMap can map any key type
+to any value type, as long as there is a hash function and an equality check
+for the key.
+
+  HashMap<K, V, Hash, Eq>
+          |  |   |     |
+          |  |   |     +-- compares two keys (default: ==)
+          |  |   +-------- turns a key into a number (default: Mix64Hash)
+          |  +------------ value type
+          +--------------- key type
+
+For example:
+
+  HashMap<long long, int> ids;                        // 64-bit IDs
+  HashMap<std::string, int> words;                    // strings
+  HashMap<int, int, DivisionHash> division;           // pick another policy
+
+Check the HashFunctions.hpp for the available hash policies.
+
+ Key Characteristics
+ * Separate chaining, each bucket is a singly linked list
+ * The number of buckets is a power of two, so the index is
+   hash(key) & (number of buckets - 1)
+ * The number of buckets doubles when there are more keys than buckets
+
+ Time Complexity
+ +------------+----------+----------+
+ | Operation  | Worst*   | Average  |
+ +------------+----------+----------+
+ | Search     | O(n)     | O(1)     |
+ | Insertion  | O(n)     | O(1)     |
+ | Deletion   | O(n)     | O(1)     |
+ +------------+----------+----------+
+ * The worst case happens when the hash function sends many keys to the same
+   bucket. A poor policy (try DivisionHash with multiples of 1024) shows it.
+
+ Space complexity: O(n)
+
+*/
+
+template <typename K, typename V, typename Hash = Mix64Hash,
+          typename Eq = std::equal_to<K>>
+class HashMap {
+ private:
+  struct Node {
+    K key;
+    V val;
+    Node* next;
+
+    // constructor
+    Node(const K& k, const V& v, Node* n) : key(k), val(v), next(n) {}
+  };
+
+  std::vector<Node*> buckets;
+  size_t count;
+  Hash hasher;
+  Eq equal;
+
+  size_t indexFor(const K& key) const {
+    return hasher(key) & (buckets.size() - 1);
+  }
+
+  // moves every node into a bucket array of the new size
+  void rehash(size_t newSize) {
+    std::vector<Node*> oldBuckets(newSize, nullptr);
+    oldBuckets.swap(buckets);
+
+    for (Node* curr : oldBuckets) {
+      while (curr) {
+        Node* next = curr->next;
+        size_t index = indexFor(curr->key);
+        curr->next = buckets[index];
+        buckets[index] = curr;
+        curr = next;
+      }
+    }
+  }
+
+  Node* findNode(const K& key) const {
+    Node* curr = buckets[indexFor(key)];
+    while (curr) {
+      if (equal(curr->key, key)) {
+        return curr;
+      }
+      curr = curr->next;
+    }
+    return nullptr;
+  }
+
+ public:
+  // constructor, the number of buckets is rounded up to a power of two. Pass
+  // a hash to fix its seed, for example SeededHash(2024) for the same layout
+  // every run
+  HashMap(size_t bucketCount = 8, const Hash& hash = Hash(),
+          const Eq& eq = Eq())
+      : count(0), hasher(hash), equal(eq) {
+    size_t size = 1;
+    while (size < bucketCount) {
+      size *= 2;
+    }
+    buckets.assign(size, nullptr);
+  }
+
+  // a map owns its nodes, so it can be moved but not copied
+  HashMap(const HashMap&) = delete;
+  HashMap& operator=(const HashMap&) = delete;
+
+  // the hash moves along with the nodes: a seeded hash drawn again would send
+  // every key to another bucket
+  HashMap(HashMap&& other) noexcept
+      : buckets(std::move(other.buckets)),
+        count(other.count),
+        hasher(std::move(other.hasher)),
+        equal(std::move(other.equal)) {
+    other.buckets.assign(1, nullptr);
+    other.count = 0;
+  }
+
+  // destructor
+  ~HashMap() { clear(); }
+
+  // returns true if the key is new, false if the old value is replaced
+  bool insert(const K& key, const V& val) {
+    Node* node = findNode(key);
+    if (node) {
+      node->val = val;
+      return false;
+    }
+
+    if (count + 1 > buckets.size()) {
+      rehash(buckets.size() * 2);
+    }
+
+    // push the new node to the front of its bucket
+    size_t index = indexFor(key);
+    buckets[index] = new Node(key, val, buckets[index]);
+    count++;
+    return true;
+  }
+
+  // returns the value of the key, or nullptr if the key is not in the map
+  V* find(const K& key) {
+    Node* node = findNode(key);
+    return node ? &node->val : nullptr;
+  }
+
+  const V* find(const K& key) const {
+    Node* node = findNode(key);
+    return node ? &node->val : nullptr;
+  }
+
+  bool contains(const K& key) const { return findNode(key) != nullptr; }
+
+  // returns the value of the key, adding a default value if it is missing
+  V& operator[](const K& key) {
+    Node* node = findNode(key);
+    if (!node) {
+      insert(key, V());
+      node = findNode(key);
+    }
+    return node->val;
+  }
+
+  bool remove(const K& key) {
+    Node** link = &buckets[indexFor(key)];
+    while (*link) {
+      if (equal((*link)->key, key)) {
+        Node* temp = *link;
+        *link = temp->next;
+        delete temp;
+        count--;
+        return true;
+      }
+      link = &(*link)->next;
+    }
+    return false;
+  }
+
+  void clear() {
+    for (Node*& head : buckets) {
+      while (head) {
+        Node* temp = head;
+        head = head->next;
+        delete temp;
+      }
+    }
+    count = 0;
+  }
+
+  // calls f(key, value) for every entry
+  template <typename F>
+  void forEach(F f) const {
+    for (Node* curr : buckets) {
+      while (curr) {
+        f(curr->key, curr->val);
+        curr = curr->next;
+      }
+    }
+  }
+
+  size_t size() const { return count; }
+
+  bool isEmpty() const { return count == 0; }
+
+  size_t bucketCount() const { return buckets.size(); }
+
+  // the memory of the bucket array and the nodes
+  size_t getBytes() const {
+    return buckets.capacity() * sizeof(Node*) + count * sizeof(Node);
+  }
+
+  // the number of nodes in the fullest bucket, shows how well the hash spreads
+  size_t longestChain() const {
+    size_t longest = 0;
+    for (Node* curr : buckets) {
+      size_t length = 0;
+      while (curr) {
+        length++;
+        curr = curr->next;
+      }
+      if (length > longest) {
+        longest = length;
+      }
+    }
+    return longest;
+  }
+
+  void printMap() const {
+    for (size_t i = 0; i < buckets.size(); i++) {
+      cout << "[" << i << "]: ";
+      if (!buckets[i]) {
+        cout << "(Empty)";
+      }
+      for (Node* curr = buckets[i]; curr; curr = curr->next) {
+        cout << curr->key << "-" << curr->val << " ";
+      }
+      cout << "\n";
+    }
+  }
+};
+
+#endif
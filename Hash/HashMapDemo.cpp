@@ -0,0 +1,105 @@
+#include <string>
+
+#include "HashMap.hpp"
+
+// function prototype
+template <typename Hash>
+void printSpread(const std::string&);
+
+int main() {
+  // 64-bit IDs as keys
+  HashMap<long long, std::string> users(4);
+  users.insert(9000000001LL, "Alan");
+  users.insert(9000000002LL, "Andy");
+  users.insert(9000000003LL, "Judy");
+  users.insert(9000000002LL, "Mandy");  // replaces Andy
+
+  cout << "\nUsers (" << users.size() << " entries, " << users.bucketCount()
+       << " buckets):\n";
+  users.printMap();
+
+  const std::string* name = users.find(9000000002LL);
+  cout << "\nLooking for 9000000002: " << (name ? *name : "No data found")
+       << "\n";
+
+  // strings as keys
+  HashMap<std::string, int> words;
+  std::string text[] = {"the", "cat", "and", "the", "hat", "and", "the", "bat"};
+  for (const std::string& word : text) {
+    words[word]++;
+  }
+
+  cout << "\nWord count:\n";
+  words.forEach([](const std::string& word, int times) {
+    cout << word << ": " << times << "\n";
+  });
+
+  // the same keys with different hash policies
+  cout << "\nLongest chain after adding 65536 keys (65536 buckets):\n";
+  cout << "policy               step 1    step 1024\n";
+  printSpread<DivisionHash>("DivisionHash");
+  printSpread<MidSquareHash>("MidSquareHash");
+  printSpread<FoldingHash>("FoldingHash");
+  printSpread<MultiplicativeHash>("MultiplicativeHash");
+  printSpread<Mix64Hash>("Mix64Hash");
+  cout << "\n";
+
+  return 0;
+}
+
+// adds keys 0, step, 2 * step, ... and reports the longest bucket
+template <typename Hash>
+void printSpread(const std::string& name) {
+  const long long steps[] = {1, 1024};
+
+  cout << name;
+  for (size_t i = name.size(); i < 21; i++) {
+    cout << " ";
+  }
+  for (long long step : steps) {
+    HashMap<long long, int, Hash> map(65536);
+    for (long long i = 0; i < 65536; i++) {
+      map.insert(i * step, 0);
+    }
+    std::string longest = std::to_string(map.longestChain());
+    cout << longest;
+    if (step == 1) {
+      for (size_t i = longest.size(); i < 10; i++) {
+        cout << " ";
+      }
+    }
+  }
+  cout << "\n";
+}
+
+// Sample Output
+/*
+
+Users (3 entries, 4 buckets):
+[0]: 9000000003-Judy 
+[1]: 9000000001-Alan 
+[2]: (Empty)
+[3]: 9000000002-Mandy 
+
+Looking for 9000000002: Mandy
+
+Word count:
+the: 3
+and: 2
+cat: 1
+bat: 1
+hat: 1
+
+Longest chain after adding 65536 keys (65536 buckets):
+policy               step 1    step 1024
+DivisionHash         1         1024
+MidSquareHash        256       1024
+FoldingHash          1         1
+MultiplicativeHash   10        2
+Mix64Hash            8         7
+
+DivisionHash keeps keys 1024 apart together: 1024 % 65536 buckets only uses
+every 1024th bucket. MidSquareHash struggles with small keys because their
+squares have few middle bits. Mix64Hash is never the best, but it is never bad.
+
+*/
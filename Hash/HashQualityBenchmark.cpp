@@ -0,0 +1,268 @@
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>  // preprocessor directive
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "HashFunctions.hpp"
+
+using std::cout;  // using declaration
+
+/*
+
+Speed and quality of every hash policy in HashFunctions.hpp.
+
+Build it with optimizations turned on, for example:
+
+  g++ -std=c++17 -O2 HashQualityBenchmark.cpp -o HashQualityBenchmark
+
+Speed: every policy hashes 1M random 64-bit keys, 8 times over. We report the
+nanoseconds and the CPU cycles per key (the time stamp counter on x86, it ticks
+at the base clock), and MB of keys per second. Then the policies that take
+strings hash 16-byte and 256-byte strings, in GB per second.
+
+Avalanche: a good hash flips every output bit with a chance of 1/2 when one
+input bit flips. For 4096 random keys, every input bit is flipped in turn and
+we count how often each of the 64 output bits changes. The bias is the largest
+distance from 1/2 over all 64 x 64 pairs: 0% is ideal, 50% means some output
+bit never (or always) follows some input bit. With 4096 keys, a perfect hash
+still shows about 3% by chance.
+
+Distribution: the tables use the lowest bits of the hash, so 1M keys are put
+into 65536 buckets by hash & 65535, 16 keys per bucket on average. We report
+the chi-square of the bucket counts divided by the degrees of freedom (about
+1.0 for a random hash, much more means clumps), and the fullest bucket. Three
+key sets:
+
+ * sequential: 0, 1, 2, ...
+ * strided:    0, 1024, 2048, ... (multiples of a power of two, as in
+               addresses or aligned offsets)
+ * random:     xorshift
+
+*/
+
+using Clock = std::chrono::steady_clock;
+
+const int KEYS = 1 << 20;
+const int BUCKET_BITS = 16;
+const int AVALANCHE_KEYS = 4096;
+
+// a tiny xorshift generator, so that every run uses the same keys
+struct Random {
+  unsigned long long state;
+
+  Random(unsigned long long seed) : state(seed) {}
+
+  unsigned long long next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+inline uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;  // no cycle counter, the column shows 0
+#endif
+}
+
+struct Speed {
+  double nsPerKey;
+  double cyclesPerKey;
+};
+
+template <typename Hash>
+Speed measureSpeed(const Hash& hash, const std::vector<uint64_t>& keys) {
+  const int passes = 8;
+  volatile size_t sink = 0;
+  size_t sum = 0;
+
+  Clock::time_point start = Clock::now();
+  uint64_t startCycles = cycles();
+  for (int pass = 0; pass < passes; pass++) {
+    for (uint64_t key : keys) {
+      sum += hash(key);
+    }
+  }
+  uint64_t endCycles = cycles();
+  Clock::time_point end = Clock::now();
+  sink = sink + sum;
+
+  double keyCount = (double)passes * keys.size();
+  Speed res;
+  res.nsPerKey =
+      std::chrono::duration<double, std::nano>(end - start).count() / keyCount;
+  res.cyclesPerKey = (endCycles - startCycles) / keyCount;
+  return res;
+}
+
+// the largest distance from 1/2 of the chance that output bit j flips when
+// input bit i flips
+template <typename Hash>
+double avalancheBias(const Hash& hash) {
+  std::vector<int> flips(64 * 64, 0);
+  Random rng(2024);
+
+  for (int k = 0; k < AVALANCHE_KEYS; k++) {
+    uint64_t key = rng.next();
+    uint64_t hashVal = hash(key);
+    for (int i = 0; i < 64; i++) {
+      uint64_t diff = hashVal ^ (uint64_t)hash(key ^ (1ULL << i));
+      for (int j = 0; j < 64; j++) {
+        flips[i * 64 + j] += (diff >> j) & 1;
+      }
+    }
+  }
+
+  double worst = 0;
+  for (int count : flips) {
+    double bias = std::fabs((double)count / AVALANCHE_KEYS - 0.5);
+    if (bias > worst) {
+      worst = bias;
+    }
+  }
+  return worst;
+}
+
+struct Spread {
+  double chiSquare;  // divided by the degrees of freedom
+  int fullest;
+};
+
+template <typename Hash>
+Spread bucketSpread(const Hash& hash, const std::vector<uint64_t>& keys) {
+  const size_t buckets = (size_t)1 << BUCKET_BITS;
+  std::vector<int> counts(buckets, 0);
+  for (uint64_t key : keys) {
+    counts[hash(key) & (buckets - 1)]++;
+  }
+
+  double expected = (double)keys.size() / buckets;
+  double chiSquare = 0;
+  int fullest = 0;
+  for (int count : counts) {
+    chiSquare += (count - expected) * (count - expected) / expected;
+    if (count > fullest) {
+      fullest = count;
+    }
+  }
+
+  Spread res;
+  res.chiSquare = chiSquare / (buckets - 1);
+  res.fullest = fullest;
+  return res;
+}
+
+void printSpread(const Spread& spread) {
+  cout << std::fixed << std::setprecision(1) << std::setw(10)
+       << spread.chiSquare << std::setw(7) << spread.fullest;
+}
+
+template <typename Hash>
+void benchmarkPolicy(const std::string& name, const Hash& hash,
+                     const std::vector<uint64_t>& sequential,
+                     const std::vector<uint64_t>& strided,
+                     const std::vector<uint64_t>& random) {
+  Speed speed = measureSpeed(hash, random);
+
+  cout << "  " << std::left << std::setw(20) << name << std::right
+       << std::fixed << std::setprecision(2) << std::setw(7) << speed.nsPerKey
+       << std::setprecision(1) << std::setw(8) << speed.cyclesPerKey
+       << std::setprecision(0) << std::setw(8) << 8000.0 / speed.nsPerKey
+       << std::setprecision(1) << std::setw(8)
+       << avalancheBias(hash) * 100 << "%";
+  printSpread(bucketSpread(hash, sequential));
+  printSpread(bucketSpread(hash, strided));
+  printSpread(bucketSpread(hash, random));
+  cout << "\n";
+}
+
+// GB of string per second
+template <typename Hash>
+double stringSpeed(const Hash& hash, size_t length) {
+  // 64 different strings, so the hash cannot be computed once and reused
+  std::vector<std::string> strings;
+  Random rng(7);
+  for (int i = 0; i < 64; i++) {
+    std::string text(length, ' ');
+    for (char& c : text) {
+      c = (char)('a' + rng.next() % 26);
+    }
+    strings.push_back(text);
+  }
+
+  const size_t totalBytes = (size_t)1 << 28;
+  size_t rounds = totalBytes / length;
+  volatile size_t sink = 0;
+  size_t sum = 0;
+
+  Clock::time_point start = Clock::now();
+  for (size_t i = 0; i < rounds; i++) {
+    sum += hash(strings[i & 63]);
+  }
+  Clock::time_point end = Clock::now();
+  sink = sink + sum;
+
+  double seconds = std::chrono::duration<double>(end - start).count();
+  return (double)rounds * length / seconds / 1e9;
+}
+
+template <typename Hash>
+void benchmarkStrings(const std::string& name, const Hash& hash) {
+  cout << "  " << std::left << std::setw(20) << name << std::right
+       << std::fixed << std::setprecision(2) << std::setw(10)
+       << stringSpeed(hash, 16) << std::setw(10) << stringSpeed(hash, 256)
+       << "\n";
+}
+
+int main() {
+  std::vector<uint64_t> sequential, strided, random;
+  Random rng(2024);
+  for (int i = 0; i < KEYS; i++) {
+    sequential.push_back((uint64_t)i);
+    strided.push_back((uint64_t)i * 1024);
+    random.push_back(rng.next());
+  }
+
+  cout << "\n==== Integer keys: speed, avalanche, spread over " << (1 << 16)
+       << " buckets ====\n";
+  cout << "  (chi2: chi-square / degrees of freedom, about 1.0 is random; max: "
+          "fullest bucket, 16 on average)\n\n";
+  cout << "                          ns  cycles    MB/s    bias"
+          "   seq chi2    max  strd chi2    max  rand chi2    max\n";
+
+  const uint64_t seed = 2024;
+  benchmarkPolicy("DivisionHash", DivisionHash(), sequential, strided, random);
+  benchmarkPolicy("ExtractionHash", ExtractionHash(), sequential, strided,
+                  random);
+  benchmarkPolicy("MidSquareHash", MidSquareHash(), sequential, strided,
+                  random);
+  benchmarkPolicy("FoldingHash", FoldingHash(), sequential, strided, random);
+  benchmarkPolicy("RadixHash", RadixHash(), sequential, strided, random);
+  benchmarkPolicy("MultiplicativeHash", MultiplicativeHash(), sequential,
+                  strided, random);
+  benchmarkPolicy("MultiplyShiftHash", MultiplyShiftHash(seed), sequential,
+                  strided, random);
+  benchmarkPolicy("Mix64Hash", Mix64Hash(), sequential, strided, random);
+  benchmarkPolicy("SeededHash", SeededHash(seed), sequential, strided, random);
+  benchmarkPolicy("WyHash", WyHash(seed), sequential, strided, random);
+  benchmarkPolicy("XxHash", XxHash(seed), sequential, strided, random);
+
+  cout << "\n==== String keys: GB per second ====\n\n";
+  cout << "                         16 bytes 256 bytes\n";
+  benchmarkStrings("Mix64Hash (FNV-1a)", Mix64Hash());
+  benchmarkStrings("SeededHash", SeededHash(seed));
+  benchmarkStrings("WyHash", WyHash(seed));
+  benchmarkStrings("XxHash", XxHash(seed));
+  cout << "\n";
+
+  return 0;
+}
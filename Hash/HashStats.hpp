@@ -0,0 +1,82 @@
+#ifndef HASH_STATISTICS
+#define HASH_STATISTICS
+
+#include <iomanip>
+#include <iostream>  // preprocessor directive
+#include <string>
+
+/*
+
+Hash Table Statistics:
+How long are the probe sequences? How long are the chains? How often does the
+table resize? These numbers tell us whether a table is too small, too big, or
+whether another collision strategy would suit the keys better.
+
+Counting every probe costs time, so the counters are only compiled in when
+HASH_STATS is defined:
+
+  g++ -std=c++17 -DHASH_STATS HashDemo.cpp -o HashDemo
+
+Without it, HASH_STATS_COUNT(...) expands to nothing and the tables have no
+extra members, so a normal build pays nothing at all.
+
+A Histogram counts how often each value (for example a probe length) happened:
+
+  search probes: 1000 samples, mean 1.30, max 5
+     1 | ################################       781
+     2 | ######                                 152
+     3 | ##                                      51
+     4 |                                         13
+     5 |                                          3
+
+*/
+
+#if defined(HASH_STATS)
+#define HASH_STATS_COUNT(statement) statement
+#else
+#define HASH_STATS_COUNT(statement)
+#endif
+
+struct Histogram {
+  static const int BINS = 16;  // the last bin also counts everything above it
+
+  long long counts[BINS + 1];
+  long long total;
+  long long sum;
+  int max;
+
+  // constructor
+  Histogram() : counts(), total(0), sum(0), max(0) {}
+
+  void record(int value) {
+    counts[value < BINS ? value : BINS]++;
+    total++;
+    sum += value;
+    max = value > max ? value : max;
+  }
+
+  double mean() const { return total ? (double)sum / total : 0.0; }
+
+  void print(const std::string& name) const {
+    std::cout << "  " << name << ": " << total << " samples, mean "
+              << std::fixed << std::setprecision(2) << mean() << ", max " << max
+              << "\n";
+
+    long long most = 0;
+    for (int i = 0; i <= BINS; i++) {
+      most = counts[i] > most ? counts[i] : most;
+    }
+
+    for (int i = 0; i <= BINS && i <= max; i++) {
+      if (!counts[i]) {
+        continue;
+      }
+      int bar = (int)(counts[i] * 32 / most);
+      std::cout << "    " << std::setw(2) << i << (i == BINS ? "+" : " ")
+                << "| " << std::string(bar, '#') << std::string(32 - bar, ' ')
+                << std::setw(10) << counts[i] << "\n";
+    }
+  }
+};
+
+#endif
@@ -1,137 +1,229 @@
 #include "HashTable.hpp"
 
-HashTable::HashTable(int tableSize) : size(tableSize), table(tableSize, -1) {}
+HashTable::HashTable(int tableSize, double maxLoad, double minLoad,
+                     uint64_t seed)
+    : size(roundUpToPowerOfTwo(tableSize)),
+      count(0),
+      dirty(0),
+      minSize(size),
+      hasher(seed),
+      maxLoadFactor(maxLoad),
+      minLoadFactor(minLoad),
+      table(size, UNINITIALIZED) {
+  // open addressing always needs an empty slot to stop a search, and shrinking
+  // must not push the load factor straight back above the limit
+  if (maxLoad <= 0 || maxLoad >= 1 || minLoad < 0 || minLoad * 2 >= maxLoad) {
+    throw std::invalid_argument("Error! Invalid load factors.\n");
+  }
+}
 /*
 
-For example, tableSize = 5:
+For example, tableSize = 5, it is rounded up to the next power of two, 8:
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  U  |  U  |  U  |  U  |  U  |  (U: uninitialized)
-         +-----+-----+-----+-----+-----+
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  U  |  U  |  U  |  U  |  U  |  U  |  U  |  (U: uninitialized)
+         +-----+-----+-----+-----+-----+-----+-----+-----+
 
 */
 
+int HashTable::roundUpToPowerOfTwo(int n) {
+  int power = 1;
+  while (power < n) {
+    power *= 2;
+  }
+  return power;
+}
+
 // calculate the hash value from the key, possibly also normailizing the result
-int HashTable::hash(int key) { return key % size; }
+int HashTable::hash(int key) {
+  return (int)(hasher((uint64_t)key) & (size - 1));
+}
 /*
 
 Division: Take the key, modulo that key by a value, and then we keep the
-remainder as the hash value.
+remainder as the hash value. Since size is a power of two, the remainder is just
+the lowest bits of the key. (The real hash scrambles the key with the seed
+first, the examples skip that step.)
 
 For example, key is 1:
 
-  hashVal = key % 5 = 1 % 5 = 1
+  hashVal = key & (8 - 1) = 0b0001 & 0b0111 = 1
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  U  |  1  |  U  |  U  |  U  |  (U: uninitialized)
-         +-----+-----+-----+-----+-----+
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  U  |  U  |  U  |  U  |  U  |  U  |  (U: uninitialized)
+         +-----+-----+-----+-----+-----+-----+-----+-----+
                   ^
 
 */
 
+int HashTable::getSize() const { return size; }
+
+int HashTable::getCount() const { return count; }
+
+double HashTable::getLoadFactor() const {
+  return (double)(count + dirty) / size;
+}
+
 // figures out where to drop the data in the event of a collision
-bool HashTable::probe(int key) {
-  int hashVal = hash(key);
-  int probeVal = (hashVal + 1) % size;
+bool HashTable::probe(int key, int hashVal) {
+  int probeVal = (hashVal + 1) & (size - 1);
 
   while (hashVal != probeVal) {
+    HASH_STATS_COUNT(probes++);
     if (table[probeVal] == UNINITIALIZED || table[probeVal] == DIRTY) {
+      if (table[probeVal] == DIRTY) {
+        dirty--;
+      }
       table[probeVal] = key;
+      count++;
       return true;
     }
-    probeVal = ++probeVal % size;
+    probeVal = (probeVal + 1) & (size - 1);
   }
 
   return false;
 }
 
+// puts the key into its home slot (index), or the next free slot after it
+bool HashTable::place(int key, int index) {
+  HASH_STATS_COUNT(probes = 1);
+  if (table[index] == UNINITIALIZED || table[index] == DIRTY) {
+    if (table[index] == DIRTY) {
+      dirty--;
+    }
+    table[index] = key;
+    count++;
+    return true;
+  }
+
+  return probe(key, index);
+}
+
+// moves every key into a new table of the given size
+void HashTable::rehash(int newSize) {
+#if defined(HASH_STATS)
+  if (newSize > size) {
+    grows++;
+  } else if (newSize < size) {
+    shrinks++;
+  } else {
+    cleanups++;
+  }
+#endif
+
+  std::vector<int> oldTable(newSize, UNINITIALIZED);
+  oldTable.swap(table);
+
+  size = newSize;
+  count = 0;
+  dirty = 0;
+
+  // dirty slots are simply left behind
+  for (int key : oldTable) {
+    if (key == UNINITIALIZED || key == DIRTY) {
+      continue;
+    }
+    int index = hash(key);
+    if (table[index] == UNINITIALIZED) {
+      table[index] = key;
+      count++;
+    } else {
+      probe(key, index);
+    }
+  }
+}
+
 // calculate the hash value from the key, possibly also normailizing the result
 bool HashTable::add(int key) {
-  int index = hash(key);
+  // every key is stored only once
+  if (find(key) != -1) {
+    return false;
+  }
 
-  if (table[index] == UNINITIALIZED) {
-    table[index] = key;
-    return true;
+  // make room before the load factor goes above the limit
+  if (count + dirty + 1 > maxLoadFactor * size) {
+    // if the keys take most of the space, double the size; if most of the used
+    // slots are dirty, cleaning them up at the same size is enough
+    rehash(count + 1 > maxLoadFactor * size / 2 ? size * 2 : size);
   }
 
-  return probe(key);
+  bool added = place(key, hash(key));
+  HASH_STATS_COUNT(addProbes.record(probes));
+  return added;
 }
 /*
 
-Here is the table:
-
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  U  |  1  |  U  |  U  |  U  |  (U: uninitialized)
-         +-----+-----+-----+-----+-----+
+Here is the table (maxLoadFactor = 0.75):
 
-Add 2, 3, 4, 5:
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  2  |  3  |  U  |  U  |  U  |  U  |  (U: uninitialized)
+         +-----+-----+-----+-----+-----+-----+-----+-----+
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
+If we want to add 9, hashVal = 9 & 7 = 1
 
-If we want to add 6...
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  2  |  3  |  U  |  U  |  U  |  U  |
+         +-----+-----+-----+-----+-----+-----+-----+-----+
                   ^
                 It's occupied
 
-Then we will iterate the table until we find an empty slot or we back to the
-first slot
+Then we will iterate the table until we find an empty slot
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-                        ^
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  2  |  3  |  U  |  U  |  U  |  U  |
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+                        ^     ^     ^
+                 occupied  occupied  empty!
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-                              ^
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  2  |  3  |  9  |  U  |  U  |  U  |
+         +-----+-----+-----+-----+-----+-----+-----+-----+
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-                                    ^
+Add 5 and 6. The load factor is 6 / 8 = 0.75, the limit.
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-            ^
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  2  |  3  |  9  |  5  |  6  |  U  |
+         +-----+-----+-----+-----+-----+-----+-----+-----+
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
-                  ^
-                we back to the first slot!
+If we want to add 7, the load factor would be 7 / 8 = 0.875. It's too full!
+Double the size and insert every key again (now hashVal = key & 15):
+
+          0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  15
+        +---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+
+  Table | U | 1 | 2 | 3 | U | 5 | 6 | U | U | 9 | U | U | U | U | U | U |
+        +---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+
+
+Then add 7 as usual:
+
+          0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  15
+        +---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+
+  Table | U | 1 | 2 | 3 | U | 5 | 6 | 7 | U | 9 | U | U | U | U | U | U |
+        +---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+
 
-The table is completely full. Return false.
+Notice 9 is back in its home slot. The rehash also breaks up the clusters.
 
 */
 
 bool HashTable::removeHelper(int key, int index) {
   int start = index;
-  index = (index + 1) % size;
+  index = (index + 1) & (size - 1);
   while (start != index) {
+    HASH_STATS_COUNT(probes++);
     if (table[index] == key) {
       table[index] = DIRTY;
-      return index;
+      return true;
     }
     if (table[index] == UNINITIALIZED) {
       return false;
     }
-    index = (index + 1) % size;
+    index = (index + 1) & (size - 1);
   }
   return false;
 }
@@ -139,30 +231,47 @@ bool HashTable::removeHelper(int key, int index) {
 // remove the value, use hash function
 bool HashTable::remove(int key) {
   int index = hash(key);
+  bool removed;
+  HASH_STATS_COUNT(probes = 1);
 
   if (table[index] == key) {
     table[index] = DIRTY;
-    return true;
+    removed = true;
+  } else {
+    removed = removeHelper(key, index);
+  }
+  HASH_STATS_COUNT(removeProbes.record(probes));
+
+  if (!removed) {
+    return false;
   }
 
-  return removeHelper(key, index);
+  count--;
+  dirty++;
+
+  // give the memory back when the table is mostly empty
+  if (size > minSize && count < minLoadFactor * size) {
+    rehash(size / 2);
+  }
+
+  return true;
 }
 /*
 
 Here is the table:
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  2  |  3  |  4  |
-         +-----+-----+-----+-----+-----+
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  2  |  3  |  9  |  U  |  U  |  U  |
+         +-----+-----+-----+-----+-----+-----+-----+-----+
                         ^
 
 If we delete 2, we'll flag it with a value marking that cell as dirty
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  D  |  3  |  4  |  (D: dirty)
-         +-----+-----+-----+-----+-----+
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  D  |  3  |  9  |  U  |  U  |  U  |  (D: dirty)
+         +-----+-----+-----+-----+-----+-----+-----+-----+
                         ^
                     It was occupied before
 
@@ -171,27 +280,40 @@ collision, we'll consider that cell as occupied and keep on digging.
 When inserting a value, we'll treat the cell as empty and we can place a value
 there.
 
+If the table has grown to 16 slots and we keep deleting until fewer than
+0.25 * 16 = 4 keys are left, the table is rehashed into 8 slots. The dirty slots
+disappear at the same time. The table never shrinks below the size it was
+created with.
 
 */
 
 int HashTable::searchHelper(int key, int index) {
   int start = index;
-  index = (index + 1) % size;
+  index = (index + 1) & (size - 1);
   while (start != index) {
+    HASH_STATS_COUNT(probes++);
     if (table[index] == key) {
       return index;
     }
     if (table[index] == UNINITIALIZED) {
       return -1;
     }
-    index = (index + 1) % size;
+    index = (index + 1) & (size - 1);
   }
   return -1;
 }
 
 // return the data found associated with the key
 int HashTable::search(int key) {
+  int index = find(key);
+  HASH_STATS_COUNT(searchProbes.record(probes));
+  return index;
+}
+
+// search without recording statistics, add uses it to check for duplicates
+int HashTable::find(int key) {
   int index = hash(key);
+  HASH_STATS_COUNT(probes = 1);
 
   if (table[index] == key) {
     return index;
@@ -201,39 +323,126 @@ int HashTable::search(int key) {
 }
 /*
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  5  |  1  |  D  |  3  |  4  |  (D: dirty)
-         +-----+-----+-----+-----+-----+
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  D  |  3  |  9  |  U  |  U  |  U  |  (D: dirty)
+         +-----+-----+-----+-----+-----+-----+-----+-----+
 
-Assume we add 10 and delete 5
+Now, we are looking for 9. The hash value is 9 & 7 = 1
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  D  |  1  | 10  |  3  |  4  |  (D: dirty)
-         +-----+-----+-----+-----+-----+
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  D  |  3  |  9  |  U  |  U  |  U  |  (D: dirty)
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+                  ^
+                It's not 9, keep digging
 
-Now, we are looking for 10. The hash value is 10 % 5 = 0
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  D  |  3  |  9  |  U  |  U  |  U  |  (D: dirty)
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+                        ^
+        It's not 9 but it's marked as dirty, so we will keep digging
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  D  |  1  | 10  |  3  |  4  |  (D: dirty)
-         +-----+-----+-----+-----+-----+
-            ^
-        It's not 10 but it's marked as dirty, so we will keep digging
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  D  |  3  |  9  |  U  |  U  |  U  |  (D: dirty)
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+                              ^
+                         It's not 9, keep digging
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  D  |  1  | 10  |  3  |  4  |  (D: dirty)
-         +-----+-----+-----+-----+-----+
-                  ^
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  D  |  3  |  9  |  U  |  U  |  U  |  (D: dirty)
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+                                    ^
+                              found! Return 4.
 
-            0     1     2     3     4
-         +-----+-----+-----+-----+-----+
-  Table  |  D  |  1  | 10  |  3  |  4  |  (D: dirty)
-         +-----+-----+-----+-----+-----+
-                        ^
-                      found! Return true.
+*/
+
+// looks up n keys, results[i] is the index of keys[i] or -1
+void HashTable::searchBatch(const int* keys, int n, int* results) {
+  int indices[BATCH_SIZE];
+
+  for (int start = 0; start < n; start += BATCH_SIZE) {
+    int end = start + BATCH_SIZE < n ? start + BATCH_SIZE : n;
+
+    // hash the whole group and start loading every home slot
+    for (int i = start; i < end; i++) {
+      indices[i - start] = hash(keys[i]);
+      prefetch(&table[indices[i - start]]);
+    }
+
+    // the same steps as search, with the hash value already known
+    for (int i = start; i < end; i++) {
+      int index = indices[i - start];
+      HASH_STATS_COUNT(probes = 1);
+      results[i] =
+          table[index] == keys[i] ? index : searchHelper(keys[i], index);
+      HASH_STATS_COUNT(searchProbes.record(probes));
+    }
+  }
+}
+
+// makes sure that n more keys fit without going above maxLoadFactor
+void HashTable::reserve(int n) {
+  while (count + dirty + n > maxLoadFactor * size) {
+    rehash(count + n > maxLoadFactor * size / 2 ? size * 2 : size);
+  }
+}
+
+// adds n keys, returns how many of them were not in the table yet
+int HashTable::addBatch(const int* keys, int n) {
+  int indices[BATCH_SIZE];
+  int added = 0;
+
+  for (int start = 0; start < n; start += BATCH_SIZE) {
+    int end = start + BATCH_SIZE < n ? start + BATCH_SIZE : n;
+
+    // grow once for the whole group, so that no rehash moves the slots we are
+    // about to prefetch
+    reserve(end - start);
+
+    for (int i = start; i < end; i++) {
+      indices[i - start] = hash(keys[i]);
+      prefetch(&table[indices[i - start]]);
+    }
+
+    for (int i = start; i < end; i++) {
+      int key = keys[i];
+      int index = indices[i - start];
+      // every key is stored only once (a key can also repeat inside the group,
+      // the earlier copy is already in the table by now)
+      if (table[index] == key || searchHelper(key, index) != -1) {
+        continue;
+      }
+      if (place(key, index)) {
+        added++;
+      }
+      HASH_STATS_COUNT(addProbes.record(probes));
+    }
+  }
+
+  return added;
+}
+/*
+
+searchBatch with BATCH_SIZE = 4 and keys 9, 3, 17, 6 (8 slots):
+
+  hash:      9 -> 1    3 -> 3    17 -> 1    6 -> 6
+  prefetch:  table[1]  table[3]  table[1]   table[6]   (all four loads start)
+
+            0     1     2     3     4     5     6     7
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+  Table  |  U  |  1  |  D  |  3  |  9  |  U  |  U  |  U  |  (D: dirty)
+         +-----+-----+-----+-----+-----+-----+-----+-----+
+                  ^           ^                 ^
+              prefetched  prefetched        prefetched
+
+  resolve:   9 -> 4    3 -> 3    17 -> -1   6 -> -1
+
+One search waits for one load. The batch waits for the slowest of four loads,
+which take about as long as one, because they overlap.
 
 */
 
@@ -250,4 +459,40 @@ void HashTable::printTable() {
     }
     cout << "\n";
   }
-};
\ No newline at end of file
+}
+
+void HashTable::printStats() const {
+  cout << "size " << size << ", keys " << count << ", dirty slots " << dirty
+       << "\n";
+  cout << std::fixed << std::setprecision(2) << "load factor "
+       << getLoadFactor() << ", dirty ratio " << (double)dirty / size << "\n";
+
+  // a cluster is a run of used (or dirty) slots, a search that lands in it may
+  // have to walk to its end. Start counting after an empty slot, so a cluster
+  // that wraps around the end of the table is counted once
+  int start = 0;
+  while (table[start] != UNINITIALIZED) {
+    start++;
+  }
+  Histogram clusters;
+  int length = 0;
+  for (int i = 1; i <= size; i++) {
+    if (table[(start + i) & (size - 1)] != UNINITIALIZED) {
+      length++;
+    } else if (length > 0) {
+      clusters.record(length);
+      length = 0;
+    }
+  }
+  clusters.print("cluster length");
+
+#if defined(HASH_STATS)
+  cout << "grows " << grows << ", shrinks " << shrinks << ", cleanups "
+       << cleanups << "\n";
+  addProbes.print("add probes");
+  searchProbes.print("search probes");
+  removeProbes.print("remove probes");
+#else
+  cout << "(compile with -DHASH_STATS for probe lengths and resize counts)\n";
+#endif
+}
@@ -2,8 +2,12 @@
 #define HASH_TABLE
 
 #include <iostream>  // preprocessor directive
+#include <stdexcept>
 #include <vector>
 
+#include "HashFunctions.hpp"
+#include "HashStats.hpp"
+
 using std::cin;  // using declaration
 using std::cout;
 
@@ -62,27 +66,109 @@ Collision Resolution Techniques:
 
 */
 
+/*
+
+Load Factor and Resizing:
+The table keeps track of how full it is and resizes itself, so we do not have to
+guess the final size when we create it.
+
+  Load Factor = (Number of Keys + Number of Dirty Slots) / Table Size
+
+ * Growth: when adding a key would push the load factor above maxLoadFactor,
+   the table doubles its size and every key is inserted again (rehash). If most
+   of the used slots are dirty, the table is rehashed at the same size instead,
+   which throws all the dirty slots away.
+ * Shrinking: when removing a key drops the number of keys below
+   minLoadFactor * size, the table halves its size (but never below the size it
+   was created with).
+
+The size is always a power of two. Then "key % size" is the same as keeping the
+lowest bits of the key, which is a single AND instead of a division:
+
+  size = 8 = 0b1000, size - 1 = 0b0111
+
+  hashVal = 13 & 0b0111 = 0b1101 & 0b0111 = 0b0101 = 5  (13 % 8 = 5)
+
+Seeded Hashing:
+Keeping the lowest bits of the key itself is easy to attack: 8, 16, 24, ... all
+land in slot 0 and form one long cluster. So the key is first scrambled with
+SipHash and a random seed that every table draws for itself (Check the
+HashFunctions.hpp), and then the lowest bits are kept:
+
+  hashVal = sipHash13(key, seed) & (size - 1)
+
+The worked examples below use hashVal = key & (size - 1) so that the numbers
+stay easy to follow.
+
+Batched Operations:
+A search in a big table usually waits for one cache miss: the slot is not in
+the cache and has to come from memory. One search at a time means one miss at a
+time. searchBatch and addBatch take many keys and work on BATCH_SIZE of them at
+once:
+
+  1. hash every key of the group
+  2. prefetch the home slot of every key (the loads now run in parallel)
+  3. resolve the keys one by one, their slots are (mostly) in the cache by now
+
+Statistics:
+printStats shows the load factor, the share of dirty slots and how long the
+clusters (runs of used slots) are. Compiled with -DHASH_STATS, it also shows how
+many slots every add, search and remove looked at, and how often the table grew,
+shrank or was cleaned up (Check the HashStats.hpp).
+
+*/
+
 const int UNINITIALIZED = -1;
 const int DIRTY = -2;
 
 class HashTable {
  private:
+  static constexpr int BATCH_SIZE = 16;
+
   int size;
+  int count;  // number of keys
+  int dirty;  // number of dirty slots
+  int minSize;
+  SeededHash hasher;  // SipHash with the secret key of this table
+  double maxLoadFactor;
+  double minLoadFactor;
   std::vector<int> table;
-  bool probe(int);
+
+#if defined(HASH_STATS)
+  int probes = 0;  // slots looked at by the current operation
+  Histogram addProbes;
+  Histogram searchProbes;
+  Histogram removeProbes;
+  int grows = 0;
+  int shrinks = 0;
+  int cleanups = 0;  // rehashed at the same size to drop the dirty slots
+#endif
+
+  bool probe(int, int);
+  bool place(int, int);
+  int find(int);
   int searchHelper(int, int);
   bool removeHelper(int, int);
+  void rehash(int);
+  void reserve(int);
+  static int roundUpToPowerOfTwo(int);
 
  public:
-  HashTable(int);
+  HashTable(int, double = 0.75, double = 0.25, uint64_t = randomSeed());
 
   int hash(int);
 
   bool add(int);
   bool remove(int);
   int search(int);
+  void searchBatch(const int*, int, int*);
+  int addBatch(const int*, int);
 
+  int getSize() const;
+  int getCount() const;
+  double getLoadFactor() const;
   void printTable();
+  void printStats() const;
 };
 
 #endif
@@ -143,4 +229,8 @@ Take 123456789 as an example:
 
    hashValue = 123456789 -- Base64 --> MTIzNDU2Nzg5
 
+Division, extraction, mid-square, folding and radix transformation are hash
+policies in HashFunctions.hpp, next to the modern mixers. The
+HashQualityBenchmark.cpp compares their speed and how well they spread keys.
+
 */
\ No newline at end of file
@@ -0,0 +1,154 @@
+#ifndef HEAVY_HITTERS
+#define HEAVY_HITTERS
+
+#include <algorithm>
+#include <functional>
+#include <iostream>  // preprocessor directive
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../Heap/MinHeap.hpp"
+#include "CountMinSketch.hpp"
+#include "HashMap.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+Heavy Hitters are the k most frequent keys of a stream (the top-k). Counting
+every key exactly needs a counter for every distinct key. Instead, this keeps
+a fixed amount of memory and reads the stream once:
+
+ * a Count-Min Sketch estimates how often each key has been seen (Check the
+   CountMinSketch.hpp)
+ * k candidates with their estimates sit in a min heap (Check the
+   Heap/MinHeap.hpp), so the weakest candidate is always at the root
+ * a HashMap from candidate to its latest estimate tells whether a key is
+   already a candidate
+
+Adding a key:
+
+  1. add it to the sketch, which returns its new estimate
+  2. a candidate already: store the new estimate in the map, done
+  3. fewer than k candidates: the key becomes one
+  4. otherwise, if the estimate beats the weakest candidate at the root, the
+     key takes its place
+
+The heap has no "increase key", so step 2 leaves the heap entry of the key
+behind with an old, lower count. Before step 4 trusts the root, it checks the
+root against the map: a root with an old count is taken out and put back with
+its latest count, until the root is up to date.
+
+  k = 3, heap (count, key)           map
+            (4, b)                   a: 9, b: 4, c: 7
+           /      \
+     (6, a)        (7, c)            (6, a) is old, a has 9 by now
+
+  add d, estimate 5: the root (4, b) is up to date and 5 > 4,
+  so b leaves and d comes in
+
+ * The estimates are upper bounds, a key that collides with a heavy key in
+   every row may look heavy too. A wider sketch makes that unlikely
+ * Memory: the sketch (w * d counters) plus k candidates, whatever the number
+   of distinct keys
+
+ Time Complexity: O(d + log k) per key, amortized
+
+ Space complexity: O(w * d + k)
+
+*/
+
+template <typename K, typename Hash = Mix64Hash,
+          typename Eq = std::equal_to<K>>
+class HeavyHitters {
+ private:
+  // a heap entry, ordered by count
+  struct Candidate {
+    uint32_t count;
+    K key;
+
+    bool operator<(const Candidate& other) const {
+      return count < other.count;
+    }
+    bool operator>(const Candidate& other) const {
+      return count > other.count;
+    }
+  };
+
+  size_t k;
+  long long total;  // keys added
+  CountMinSketch<Hash> sketch;
+  MinHeap<Candidate> heap;
+  HashMap<K, uint32_t, Hash, Eq> candidates;  // key -> latest estimate
+
+ public:
+  // constructor, keeps the top k keys with a sketch of width x depth counters
+  HeavyHitters(size_t topK, size_t width = 2048, int depth = 4,
+               const Hash& hash = Hash())
+      : k(topK), total(0), sketch(width, depth, hash), candidates(topK * 2) {
+    if (topK == 0) {
+      throw std::invalid_argument("Error! There must be a top key or more.\n");
+    }
+  }
+
+  void add(const K& key) {
+    total++;
+    uint32_t estimate = sketch.add(key);
+
+    uint32_t* known = candidates.find(key);
+    if (known) {
+      *known = estimate;
+      return;
+    }
+
+    if (heap.size() < k) {
+      candidates.insert(key, estimate);
+      heap.insert(Candidate{estimate, key});
+      return;
+    }
+
+    // bring the root up to date, its count may be old
+    Candidate weakest = heap.getMin();
+    uint32_t latest = *candidates.find(weakest.key);
+    while (latest != weakest.count) {
+      heap.extractMin();
+      heap.insert(Candidate{latest, weakest.key});
+      weakest = heap.getMin();
+      latest = *candidates.find(weakest.key);
+    }
+
+    if (estimate > weakest.count) {
+      heap.extractMin();
+      candidates.remove(weakest.key);
+      candidates.insert(key, estimate);
+      heap.insert(Candidate{estimate, key});
+    }
+  }
+
+  // the candidates and their estimated counts, the most frequent first
+  std::vector<std::pair<K, uint32_t>> top() const {
+    std::vector<std::pair<K, uint32_t>> res;
+    candidates.forEach(
+        [&](const K& key, uint32_t count) { res.emplace_back(key, count); });
+    std::sort(res.begin(), res.end(),
+              [](const std::pair<K, uint32_t>& a,
+                 const std::pair<K, uint32_t>& b) {
+                return a.second > b.second;
+              });
+    return res;
+  }
+
+  // an upper bound of how often the key was added
+  uint32_t estimate(const K& key) const { return sketch.estimate(key); }
+
+  long long getTotal() const { return total; }
+
+  size_t getBytes() const {
+    return sketch.getBytes() + candidates.getBytes() +
+           heap.size() * sizeof(Candidate);
+  }
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+#include "HashMap.hpp"
+#include "HeavyHitters.hpp"
+
+// a tiny xorshift generator, so that every run uses the same keys
+struct Random {
+  unsigned long long state;
+
+  Random(unsigned long long seed) : state(seed) {}
+
+  unsigned long long next() {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+int main() {
+  const int DISTINCT = 200000;
+  const int STREAM = 2000000;
+  const size_t TOP = 10;
+
+  // Zipf-like stream: key i turns up about 1 / (i + 1) as often as key 0
+  std::vector<double> cumulative(DISTINCT);
+  double sum = 0;
+  for (int i = 0; i < DISTINCT; i++) {
+    sum += 1.0 / (i + 1);
+    cumulative[i] = sum;
+  }
+
+  // declaration
+  HeavyHitters<int> hitters(TOP);  // 2048 x 4 counters
+  HashMap<int, long long> exact;   // the exact way: a counter for every key
+
+  Random rng(2024);
+  for (int n = 0; n < STREAM; n++) {
+    double pick = (rng.next() >> 11) * (1.0 / (1ULL << 53)) * sum;
+    int key = (int)(std::lower_bound(cumulative.begin(), cumulative.end(),
+                                     pick) -
+                    cumulative.begin());
+    // spread the ranks over the key space, the top keys are not 0, 1, 2...
+    key = key * 7919 + 13;
+    hitters.add(key);
+    exact[key]++;
+  }
+
+  std::vector<std::pair<int, long long>> counted;
+  exact.forEach([&](int key, long long count) {
+    counted.emplace_back(key, count);
+  });
+  std::sort(counted.begin(), counted.end(),
+            [](const std::pair<int, long long>& a,
+               const std::pair<int, long long>& b) {
+              return a.second > b.second;
+            });
+
+  cout << "\n" << STREAM << " keys, " << exact.size()
+       << " distinct, the top " << TOP << "\n\n";
+  cout << "       key   estimate      exact   error\n";
+
+  std::vector<std::pair<int, uint32_t>> top = hitters.top();
+  size_t found = 0;
+  for (const std::pair<int, uint32_t>& hitter : top) {
+    long long count = *exact.find(hitter.first);
+    cout << std::setw(10) << hitter.first << std::setw(11) << hitter.second
+         << std::setw(11) << count << std::setw(7) << std::fixed
+         << std::setprecision(2) << (hitter.second - count) * 100.0 / count
+         << "%\n";
+    for (size_t i = 0; i < TOP; i++) {
+      found += counted[i].first == hitter.first;
+    }
+  }
+
+  cout << "\n" << found << " of the exact top " << TOP << " found\n";
+  cout << "HeavyHitters: " << hitters.getBytes() / 1024
+       << " KB, HashMap: " << exact.getBytes() / 1024 << " KB\n\n";
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+2000000 keys, 158664 distinct, the top 10
+
+       key   estimate      exact   error
+        13     156193     156193   0.00%
+      7932      78553      78553   0.00%
+     15851      52305      52305   0.00%
+     23770      39536      39536   0.00%
+     31689      31404      31404   0.00%
+     39608      25832      25832   0.00%
+     47527      22229      22229   0.00%
+     55446      19477      19477   0.00%
+     63365      17128      17128   0.00%
+     71284      15766      15766   0.00%
+
+10 of the exact top 10 found
+HeavyHitters: 32 KB, HashMap: 5766 KB
+
+The heavy keys own most of their counters, so their estimates are exact here.
+The sketch stays at 32 KB for any number of distinct keys, while the HashMap
+needs a node for every one of them.
+
+*/
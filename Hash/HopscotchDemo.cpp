@@ -0,0 +1,78 @@
+#include "HopscotchHashTable.cpp"
+
+int main() {
+  // declaration
+  HopscotchHashTable table(64, 0.9, 2024);  // 64 slots, a fixed seed
+  // 24 keys in 64 slots, some of them share a home
+  for (int key = 1; key <= 24; key++) {
+    table.add(key * 10);
+  }
+  table.remove(30);
+
+  cout << "\nTable (" << table.getCount() << " keys, " << table.getSize()
+       << " slots, empty slots that are nobody's home are not shown):\n";
+  table.printTable();
+
+  int lookups[] = {70, 30, 65};
+  cout << "\n";
+  for (int key : lookups) {
+    int index = table.search(key);
+    if (index != -1) {
+      cout << "...Found " << key << " at slot " << index << "\n";
+    } else {
+      cout << "...Number " << key << " not found!\n";
+    }
+  }
+
+  // keep adding until the table grows
+  int key = 250;
+  while (table.getSize() == 64) {
+    table.add(key);
+    key += 10;
+  }
+  cout << "\nThe table grew while adding " << key - 10 << ": "
+       << table.getCount() << " keys, " << table.getSize() << " slots\n\n";
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+
+Table (23 keys, 64 slots, empty slots that are nobody's home are not shown):
+Index 1: 220 (home 1)  hop { 0 }
+Index 6: 230 (home 6)  hop { 0 }
+Index 7: 10 (home 7)  hop { 0 }
+Index 10: 200 (home 10)  hop { 0 }
+Index 11: 40 (home 11)  hop { 0 }
+Index 12: 180 (home 12)  hop { 0 }
+Index 14: 100 (home 14)  hop { 0 1 }
+Index 15: 160 (home 14)
+Index 22: 130 (home 22)  hop { 0 }
+Index 23: 150 (home 23)  hop { 0 }
+Index 26: 190 (home 26)  hop { 0 }
+Index 39: 50 (home 39)  hop { 0 2 }
+Index 40: 140 (home 40)  hop { 0 }
+Index 41: 210 (home 39)
+Index 42: 60 (home 42)  hop { 0 1 }
+Index 43: 170 (home 42)
+Index 45: 70 (home 45)  hop { 0 }
+Index 48: 110 (home 48)  hop { 0 }
+Index 51: 240 (home 51)  hop { 0 }
+Index 52: 120 (home 52)  hop { 0 }
+Index 59: 90 (home 59)  hop { 0 }
+Index 62: 20 (home 62)  hop { 0 1 }
+Index 63: 80 (home 62)
+
+...Found 70 at slot 45
+...Number 30 not found!
+...Number 65 not found!
+
+The table grew while adding 590: 58 keys, 128 slots
+
+Slot 39 is the home of 50 and 210, its hop { 0 2 } sends a search to slots 39
+and 41 only, even though slot 40 holds a key too. The table grew because 58
+keys in 64 slots is over the 0.9 load factor, not because an add failed.
+
+*/
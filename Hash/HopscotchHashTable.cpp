@@ -0,0 +1,249 @@
+#include "HopscotchHashTable.hpp"
+
+HopscotchHashTable::HopscotchHashTable(int tableSize, double maxLoad,
+                                       uint64_t seed)
+    : count(0), maxLoadFactor(maxLoad), hasher(seed) {
+  // round up to a power of two, and at least one neighborhood
+  size = H;
+  while (size < tableSize) {
+    size *= 2;
+  }
+  table.assign(size, Slot());
+  used.assign(size / 64 + 1, 0);
+}
+/*
+
+For example, tableSize = 32 (H = 32): one neighborhood covers the whole table,
+and it wraps around, the neighborhood of slot 30 is 30, 31, 0, 1, ..., 29
+
+            0     1     2           31
+         +-----+-----+-----+     +-----+
+  Key    |     |     |     | ... |     |
+         +-----+-----+-----+     +-----+
+  Hop    |  0  |  0  |  0  | ... |  0  |
+         +-----+-----+-----+     +-----+
+
+*/
+
+bool HopscotchHashTable::isUsed(int index) const {
+  return (used[index >> 6] >> (index & 63)) & 1;
+}
+
+void HopscotchHashTable::setUsed(int index, bool isSet) {
+  if (isSet) {
+    used[index >> 6] |= 1ULL << (index & 63);
+  } else {
+    used[index >> 6] &= ~(1ULL << (index & 63));
+  }
+}
+
+int HopscotchHashTable::home(int key) const {
+  return (int)(hasher((uint64_t)key) & (size - 1));
+}
+
+int HopscotchHashTable::getSize() const { return size; }
+
+int HopscotchHashTable::getCount() const { return count; }
+
+double HopscotchHashTable::getLoadFactor() const {
+  return (double)count / size;
+}
+
+// the memory of the slots and the used bits
+size_t HopscotchHashTable::getBytes() const {
+  return table.capacity() * sizeof(Slot) + used.capacity() * sizeof(uint64_t);
+}
+
+// returns the slot of the key, or -1 if the key is not in the table
+int HopscotchHashTable::search(int key) const {
+  int start = home(key);
+  uint32_t hop = table[start].hop;
+
+  // check only the slots the bitmap points at, lowest first
+  while (hop) {
+    int index = (start + __builtin_ctz(hop)) & (size - 1);
+    if (table[index].key == key) {
+      return index;
+    }
+    hop &= hop - 1;  // clear the lowest set bit
+  }
+
+  return -1;
+}
+/*
+
+            3     4     5     6
+         +-----+-----+-----+-----+
+  Key    | 12  |  9  | 40  |     |
+         +-----+-----+-----+-----+
+  Hop    | 101 | 1   |     |     |
+         +-----+-----+-----+-----+
+
+Searching 40 (home 3): hop = 101 (bits 0 and 2)
+
+  bit 0: slot 3 holds 12, not 40
+  bit 2: slot 5 holds 40, found!
+
+Searching 33 (home 4): hop = 1 (bit 0)
+
+  bit 0: slot 4 holds 9, not 33. No more bits, 33 is not in the table
+
+Slot 6 is never checked: no key of home 3 or 4 lives there.
+
+*/
+
+// puts a new key into the neighborhood of its home, moving other keys closer
+// to the home if needed. Returns false if no room could be made
+bool HopscotchHashTable::place(int key) {
+  int start = home(key);
+
+  // the first empty slot at or after the home
+  int dist = 0;
+  while (dist < ADD_RANGE && dist < size &&
+         isUsed((start + dist) & (size - 1))) {
+    dist++;
+  }
+  if (dist == ADD_RANGE || dist == size) {
+    return false;
+  }
+
+  // move the empty slot backward until it is in the neighborhood
+  while (dist >= H) {
+    int empty = (start + dist) & (size - 1);
+    bool moved = false;
+
+    // the farthest slot first, so the empty slot hops as far as it can
+    for (int back = H - 1; back > 0 && !moved; back--) {
+      int candidate = (empty - back) & (size - 1);
+      uint32_t hop = table[candidate].hop;
+
+      // a key of candidate's home that lives before the empty slot, it may
+      // move to the empty slot (back slots away from its home)
+      int i = hop ? __builtin_ctz(hop) : H;
+      if (i < back) {
+        int from = (candidate + i) & (size - 1);
+        table[empty].key = table[from].key;
+        setUsed(empty, true);
+        table[candidate].hop |= 1u << back;
+        table[candidate].hop &= ~(1u << i);
+        setUsed(from, false);
+        dist -= back - i;
+        moved = true;
+      }
+    }
+
+    if (!moved) {
+      return false;
+    }
+  }
+
+  int index = (start + dist) & (size - 1);
+  table[index].key = key;
+  setUsed(index, true);
+  table[start].hop |= 1u << dist;
+  return true;
+}
+/*
+
+Adding 7 (home 0), H = 4 to keep the picture small:
+
+            0     1     2     3     4     5
+         +-----+-----+-----+-----+-----+-----+
+  Key    |  a  |  b  |  c  |  d  |  e  |     |    empty slot 5, dist 5 >= H
+         +-----+-----+-----+-----+-----+-----+
+
+  back 3: slot 2, its hop points at d in slot 3, 3 is before 5: move d to 5
+
+            0     1     2     3     4     5
+         +-----+-----+-----+-----+-----+-----+
+  Key    |  a  |  b  |  c  |     |  e  |  d  |    empty slot 3, dist 3 < H
+         +-----+-----+-----+-----+-----+-----+
+
+  7 goes to slot 3, bit 3 is set in the hop of slot 0
+
+*/
+
+// doubles the table (more if needed) and adds every key again
+void HopscotchHashTable::grow() {
+  std::vector<int> keys;
+  for (int i = 0; i < size; i++) {
+    if (isUsed(i)) {
+      keys.push_back(table[i].key);
+    }
+  }
+
+  bool done = false;
+  while (!done) {
+    size *= 2;
+    table.assign(size, Slot());
+    used.assign(size / 64 + 1, 0);
+    done = true;
+
+    for (int key : keys) {
+      if (!place(key)) {
+        // very unlucky, try again with even more slots
+        done = false;
+        break;
+      }
+    }
+  }
+}
+
+bool HopscotchHashTable::add(int key) {
+  // every key is stored only once
+  if (search(key) != -1) {
+    return false;
+  }
+
+  if (count + 1 > maxLoadFactor * size) {
+    grow();
+  }
+  while (!place(key)) {
+    grow();
+  }
+  count++;
+  return true;
+}
+
+bool HopscotchHashTable::remove(int key) {
+  int index = search(key);
+
+  if (index == -1) {
+    return false;
+  }
+
+  int start = home(key);
+  table[start].hop &= ~(1u << ((index - start) & (size - 1)));
+  setUsed(index, false);
+  count--;
+  return true;
+}
+
+// prints the slots that hold a key or are the home of a key, a table has at
+// least 32 slots and most of them are empty in a small example
+void HopscotchHashTable::printTable() const {
+  for (int i = 0; i < size; i++) {
+    if (!isUsed(i) && !table[i].hop) {
+      continue;
+    }
+
+    cout << "Index " << i << ": ";
+    if (isUsed(i)) {
+      cout << table[i].key << " (home " << home(table[i].key) << ")";
+    } else {
+      cout << "(Empty)";
+    }
+
+    // the offsets of the keys that call this slot home
+    if (table[i].hop) {
+      cout << "  hop {";
+      for (int bit = 0; bit < H; bit++) {
+        if (table[i].hop & (1u << bit)) {
+          cout << " " << bit;
+        }
+      }
+      cout << " }";
+    }
+    cout << "\n";
+  }
+}
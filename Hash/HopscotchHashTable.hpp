@@ -0,0 +1,131 @@
+#ifndef HOPSCOTCH_HASH_TABLE
+#define HOPSCOTCH_HASH_TABLE
+
+#include <cstdint>
+#include <iostream>  // preprocessor directive
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+Hopscotch Hashing is open addressing where every key stays close to its home
+slot: it always sits in the neighborhood of H (32) slots that starts at its
+home. Each home slot keeps a bitmap (hop) of which slots of its neighborhood
+hold its keys, so a search reads the bitmap and checks only those slots.
+
+  home slot 3, H = 4 to keep the picture small
+
+  index   3     4     5     6     7
+       +-----+-----+-----+-----+-----+
+  key  | 12  |  9  | 40  |     | ... |      12 and 40 have home 3,
+       +-----+-----+-----+-----+-----+      9 has home 4
+  hop  | 0101|  ...                         bit 0 --> slot 3, bit 2 --> slot 5
+
+  search 40: hop of slot 3 is 0101 --> check slot 3 (12), slot 5 (40) found!
+
+Adding a key: probe linearly for an empty slot. If it is within H slots of the
+home, the key goes there. Otherwise the empty slot "hops" backward: a key that
+lives just before the empty slot and may move into it (it stays within its own
+neighborhood) moves there, and its old slot becomes the empty one. Repeat until
+the empty slot is close enough to the home:
+
+  add 7 (home 0), H = 4, the first empty slot is 5:
+
+  index   0     1     2     3     4     5
+       +-----+-----+-----+-----+-----+-----+
+  key  |  a  |  b  |  c  |  d  |  e  |     |     5 is 5 slots away, too far
+       +-----+-----+-----+-----+-----+-----+
+                         d (home 2) may move to 5, it is 3 away from home
+  key  |  a  |  b  |  c  |     |  e  |  d  |     3 is 3 slots away, 7 fits
+  key  |  a  |  b  |  c  |  7  |  e  |  d  |
+
+If no key can make room, the table doubles and every key is added again.
+
+ * The table wraps around: slot (home + i) & (size - 1), and it has at least H
+   slots
+ * A search never looks outside one neighborhood, and usually checks one or two
+   slots, so it touches one or two cache lines even at a 90% load factor
+ * Moving a key is a copy into the empty slot and two bit flips, one key at a
+   time. A reader racing with the move finds the key in the old or in the new
+   slot (with a version counter per neighborhood, it knows when to retry). In
+   Robin Hood, an add can shift a whole cluster at once.
+ * Slots are hashed with a seeded SipHash (Check the HashFunctions.hpp)
+
+ Time Complexity
+ +------------+-----------+-----------+
+ | Operation  | Worst     | Average   |
+ +------------+-----------+-----------+
+ | Search     | O(H)      | O(1)      |
+ | Insertion  | O(n)*     | O(1)      |
+ | Deletion   | O(H)      | O(1)      |
+ +------------+-----------+-----------+
+ * Only when the table has to grow
+
+ Space complexity: O(n), a slot is a 4-byte bitmap and a 4-byte key, plus one
+ bit that tells whether it is used
+
+ Pros:
+ * Fast at a high load factor (less memory for the same number of keys): a
+   table of a million slots fills to about 80-85% before an add fails and it
+   has to grow
+ * Searching a missing key is bounded too: one bitmap, at most H slots
+ * No tombstones: a removed key frees its slot and clears one bit
+
+ Cons:
+ * The bitmap doubles the slot of an int key (4 bytes of key, 4 of bitmap,
+   8 bytes in all against 4 in HashTable). The high load factor pays off for
+   bigger entries, where the 4 bytes are a small part of the slot
+ * Adding into a nearly full table can move several keys, and keys move during
+   an add, so an index returned by search is only valid until the next add
+
+*/
+
+class HopscotchHashTable {
+ private:
+  // slots in a neighborhood, one bit of the 32-bit bitmap each
+  static constexpr int H = 32;
+  static constexpr int ADD_RANGE = 4096;  // how far add looks for an empty slot
+
+  // where the keys whose home is this slot live, and the key of this slot.
+  // 8 bytes: whether the slot is used is kept in a separate bit array
+  struct Slot {
+    uint32_t hop;  // bit i is set if slot home + i holds a key of this home
+    int key;
+
+    // constructor
+    Slot() : hop(0), key(0) {}
+  };
+
+  int size;  // always a power of two, at least H
+  int count;
+  double maxLoadFactor;
+  SeededHash hasher;  // SipHash with the secret key of this table
+  std::vector<Slot> table;
+  std::vector<uint64_t> used;  // bit i is set if slot i holds a key
+
+  bool isUsed(int) const;
+  void setUsed(int, bool);
+  int home(int) const;
+  bool place(int);
+  void grow();
+
+ public:
+  // constructor
+  HopscotchHashTable(int = 64, double = 0.9, uint64_t = randomSeed());
+
+  bool add(int);
+  bool remove(int);
+  int search(int) const;
+
+  int getSize() const;
+  int getCount() const;
+  double getLoadFactor() const;
+  size_t getBytes() const;
+  void printTable() const;
+};
+
+#endif
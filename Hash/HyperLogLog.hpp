@@ -0,0 +1,271 @@
+#ifndef HYPER_LOG_LOG
+#define HYPER_LOG_LOG
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>  // preprocessor directive
+#include <stdexcept>
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+HyperLogLog estimates how many distinct keys a stream has, in a few kilobytes,
+no matter how long the stream is. A hash table that remembers every key needs
+memory for every distinct key; HyperLogLog only remembers the most unlikely
+hash value it has seen.
+
+The idea: in random 64-bit hash values, a value that starts with k zero bits
+turns up about once in 2^k values. If the longest run of leading zeros so far
+is 20, we have probably seen about 2^20 distinct values. Seeing a key again
+gives the same hash value, so repeats change nothing.
+
+One run is a noisy guess, so the first p bits of the hash pick one of m = 2^p
+registers, and every register keeps the longest run (+1) of the keys sent to
+it. The estimate combines the m registers with a harmonic mean:
+
+  hash = 0110 0000 1...      p = 4
+         ^^^^ ^^^^^^
+   register 6  4 zeros, then a 1: rank 5
+
+  registers[6] = max(registers[6], 5)
+
+  estimate = alpha * m^2 / (2^-registers[0] + ... + 2^-registers[m - 1])
+
+ * The error is about 1.04 / sqrt(m): with p = 14 (16384 registers of one byte,
+   16 KB), about 0.8%
+ * With few keys most registers are still 0, and the estimate switches to
+   linear counting: m * ln(m / number of zero registers)
+
+Sparse Representation:
+A new sketch has seen few keys, so most of the m registers are 0. Instead of
+the registers, it keeps a sorted list of (index, rank) pairs, with the index
+taken from the first 25 bits of the hash instead of p bits. While the list is
+short, it costs less memory than the registers, and it counts more exactly
+(linear counting over 2^25 buckets). New pairs go to an unsorted buffer first
+and are merged into the list in batches. When the list would take more bytes
+than the registers, the sketch turns dense.
+
+Merging:
+The register of a key depends only on the key, so the sketch of two streams is
+the register-wise max of their sketches. Every thread can keep its own sketch,
+and merging them costs m byte comparisons, without going through the keys
+again. Both sketches need the same precision and the same hash function (the
+same seed for a seeded policy).
+
+  HyperLogLog<Hash>
+              |
+              +-- turns a key into 64 bits (default: Mix64Hash). It must spread
+                  the keys over all 64 bits, so DivisionHash and the other
+                  textbook functions do not work here (Check the
+                  HashQualityBenchmark.cpp)
+
+ Time Complexity: O(1) per add, O(m) per estimate and per merge
+
+ Space complexity: O(m), independent of the number of keys
+
+*/
+
+template <typename Hash = Mix64Hash>
+class HyperLogLog {
+ private:
+  static const int SPARSE_BITS = 25;
+
+  int precision;
+  bool sparse;
+  std::vector<uint8_t> registers;  // the dense sketch
+  std::vector<uint32_t> list;      // sorted (index << 6 | rank), one per index
+  std::vector<uint32_t> pending;   // new sparse pairs, not sorted yet
+  Hash hasher;
+
+  size_t registerCount() const { return (size_t)1 << precision; }
+
+  // the number of leading zeros of the bits after the first width bits, + 1
+  static int rank(uint64_t hashVal, int width) {
+    uint64_t rest = hashVal << width;
+    return rest ? __builtin_clzll(rest) + 1 : 64 - width + 1;
+  }
+
+  void addDense(size_t index, int r) {
+    if (registers[index] < r) {
+      registers[index] = (uint8_t)r;
+    }
+  }
+
+  // the dense register and rank of a sparse pair: the 25 - p index bits the
+  // dense sketch does not use come first in its rank
+  void addSparsePair(uint32_t pair) {
+    uint32_t index = pair >> 6;
+    int r = pair & 63;
+    int extraBits = SPARSE_BITS - precision;
+    uint32_t extra = index & ((1u << extraBits) - 1);
+    if (extra) {
+      r = extraBits - (32 - __builtin_clz(extra)) + 1;
+    } else {
+      r += extraBits;
+    }
+    addDense(index >> extraBits, r);
+  }
+
+  // sorts the pairs and keeps the highest rank of every index
+  static void normalize(std::vector<uint32_t>& pairs) {
+    std::sort(pairs.begin(), pairs.end());
+    size_t kept = 0;
+    for (size_t i = 0; i < pairs.size(); i++) {
+      // within one index the ranks are sorted, so the last pair is the highest
+      if (i + 1 < pairs.size() && (pairs[i + 1] >> 6) == (pairs[i] >> 6)) {
+        continue;
+      }
+      pairs[kept++] = pairs[i];
+    }
+    pairs.resize(kept);
+  }
+
+  // merges the buffer into the list, and turns dense if the list got too big
+  void compact() {
+    list.insert(list.end(), pending.begin(), pending.end());
+    pending.clear();
+    normalize(list);
+    if (list.size() * sizeof(uint32_t) > registerCount()) {
+      toDense();
+    }
+  }
+
+  void toDense() {
+    registers.assign(registerCount(), 0);
+    for (uint32_t pair : list) {
+      addSparsePair(pair);
+    }
+    for (uint32_t pair : pending) {
+      addSparsePair(pair);
+    }
+    sparse = false;
+    std::vector<uint32_t>().swap(list);
+    std::vector<uint32_t>().swap(pending);
+  }
+
+  static double linearCounting(double buckets, double empty) {
+    return buckets * std::log(buckets / empty);
+  }
+
+ public:
+  // constructor, 2^p registers, p from 4 to 18
+  HyperLogLog(int p = 14, const Hash& hash = Hash())
+      : precision(p), sparse(true), hasher(hash) {
+    if (p < 4 || p > 18) {
+      throw std::invalid_argument("Error! The precision must be 4 to 18.\n");
+    }
+  }
+
+  template <typename K>
+  void add(const K& key) {
+    addHash((uint64_t)hasher(key));
+  }
+
+  // adds a 64-bit hash value that was already computed
+  void addHash(uint64_t hashVal) {
+    if (sparse) {
+      uint32_t index = (uint32_t)(hashVal >> (64 - SPARSE_BITS));
+      pending.push_back(index << 6 | rank(hashVal, SPARSE_BITS));
+      // a buffer of a quarter of the dense size, at most
+      if (pending.size() * sizeof(uint32_t) * 4 >= registerCount()) {
+        compact();
+      }
+    } else {
+      addDense(hashVal >> (64 - precision), rank(hashVal, precision));
+    }
+  }
+
+  double estimate() const {
+    if (sparse) {
+      std::vector<uint32_t> pairs(list);
+      pairs.insert(pairs.end(), pending.begin(), pending.end());
+      normalize(pairs);
+      double buckets = (double)(1 << SPARSE_BITS);
+      return linearCounting(buckets, buckets - pairs.size());
+    }
+
+    double m = (double)registerCount();
+    double sum = 0;
+    int zeros = 0;
+    for (uint8_t r : registers) {
+      sum += std::ldexp(1.0, -r);
+      zeros += r == 0;
+    }
+
+    double alpha = precision == 4   ? 0.673
+                   : precision == 5 ? 0.697
+                   : precision == 6 ? 0.709
+                                    : 0.7213 / (1 + 1.079 / m);
+    double raw = alpha * m * m / sum;
+
+    // the raw estimate is too high for a few keys, while registers are empty
+    if (raw <= 2.5 * m && zeros > 0) {
+      return linearCounting(m, zeros);
+    }
+    return raw;
+  }
+
+  // adds every key of the other sketch to this one
+  void merge(const HyperLogLog& other) {
+    // a sketch already holds all of its own keys
+    if (&other == this) {
+      return;
+    }
+    if (other.precision != precision) {
+      throw std::invalid_argument("Error! The precisions are different.\n");
+    }
+
+    if (sparse && other.sparse) {
+      pending.insert(pending.end(), other.list.begin(), other.list.end());
+      pending.insert(pending.end(), other.pending.begin(),
+                     other.pending.end());
+      compact();
+      return;
+    }
+
+    if (sparse) {
+      toDense();
+    }
+    if (other.sparse) {
+      for (uint32_t pair : other.list) {
+        addSparsePair(pair);
+      }
+      for (uint32_t pair : other.pending) {
+        addSparsePair(pair);
+      }
+    } else {
+      for (size_t i = 0; i < registers.size(); i++) {
+        addDense(i, other.registers[i]);
+      }
+    }
+  }
+
+  void clear() {
+    sparse = true;
+    std::vector<uint8_t>().swap(registers);
+    list.clear();
+    pending.clear();
+  }
+
+  bool isSparse() const { return sparse; }
+
+  int getPrecision() const { return precision; }
+
+  // the expected relative error of an estimate
+  double getStandardError() const {
+    return 1.04 / std::sqrt((double)registerCount());
+  }
+
+  size_t getBytes() const {
+    return registers.capacity() +
+           (list.capacity() + pending.capacity()) * sizeof(uint32_t);
+  }
+};
+
+#endif
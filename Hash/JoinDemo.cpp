@@ -0,0 +1,63 @@
+#include <algorithm>
+
+#include "HashJoin.cpp"
+
+void printPairs(std::vector<JoinPair> pairs) {
+  // the pairs come out in no particular order, sort them to print them
+  std::sort(pairs.begin(), pairs.end(),
+            [](const JoinPair& a, const JoinPair& b) {
+              return a.key != b.key ? a.key < b.key : a.right < b.right;
+            });
+  for (const JoinPair& pair : pairs) {
+    cout << "  (" << pair.key << ", " << pair.left << ", " << pair.right
+         << ")\n";
+  }
+}
+
+int main() {
+  // declaration
+  std::vector<Row> left = {{1, 10}, {2, 20}, {3, 30}};
+  std::vector<Row> right = {{2, 200}, {1, 100}, {2, 201}, {4, 400}};
+
+  cout << "\nOne shared table, 2 threads:\n";
+  HashJoin shared(2, NO_PARTITIONS);
+  printPairs(shared.run(left, right));
+
+  cout << "\n4 partitions (2 bits), 2 threads:\n";
+  HashJoin partitioned(2, 2);
+  printPairs(partitioned.run(left, right));
+
+  // a bigger join: every key of the left appears twice on the right
+  std::vector<Row> small, large;
+  for (int i = 0; i < 100000; i++) {
+    small.push_back(Row{i, i});
+    large.push_back(Row{i, -i});
+    large.push_back(Row{i + 50000, -i});
+  }
+  HashJoin l2(4);
+  cout << "\n" << small.size() << " x " << large.size() << " rows, "
+       << l2.getThreads() << " threads, L2-sized partitions: "
+       << l2.run(small, large).size() << " pairs\n\n";
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+One shared table, 2 threads:
+  (1, 10, 100)
+  (2, 20, 200)
+  (2, 20, 201)
+
+4 partitions (2 bits), 2 threads:
+  (1, 10, 100)
+  (2, 20, 200)
+  (2, 20, 201)
+
+100000 x 200000 rows, 4 threads, L2-sized partitions: 150000 pairs
+
+The left input is smaller, so it is built and the right input probes it. The
+pairs still list the left payload first.
+
+*/
@@ -0,0 +1,360 @@
+#ifndef LRU_CACHE
+#define LRU_CACHE
+
+#include <functional>
+#include <iostream>  // preprocessor directive
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "HashFunctions.hpp"
+#include "NodePool.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+An LRU (Least Recently Used) Cache keeps a bounded number of key-value pairs.
+When it is full, adding a new pair throws out the pair that was used the
+longest time ago.
+
+It needs two things at once:
+ * find a key quickly                 --> a hash table (separate chaining)
+ * know which key was used the least  --> a doubly linked list, most recently
+                                          used at the head, least at the tail
+
+Instead of a hash table of pointers into a separate list (two allocations per
+entry), every node is in both at the same time. It has a chain pointer for its
+bucket and prev/next pointers for the list (an intrusive list):
+
+  buckets                          recency list
+  +---+                            head                             tail
+  | 0 | -> [7] -> [3]               |                                |
+  +---+                             v                                v
+  | 1 | -> (empty)                 [3] <--> [12] <--> [7] <--> [5] <--> [9]
+  +---+                           newest                           oldest
+  | 2 | -> [12] -> [9]
+  +---+                          get(7): [7] moves to the head
+  | 3 | -> [5]                    put(4) when full: [9] at the tail is evicted
+  +---+
+
+Every operation touches a few pointers only:
+ * get: find the node in its bucket, unlink it from the list and put it at
+   the head
+ * put: the same for a key that is there, otherwise a new node goes to the
+   head of the list and the front of its bucket; then nodes are evicted from
+   the tail while the cache is over its limit
+ * the nodes come from a NodePool, so an evicted node's memory is reused by
+   the next put
+
+The limit is a number of entries, a number of bytes, or both (0 means no
+limit). The bytes of an entry come from the Bytes policy, by default the size
+of the key and the value plus the characters of a std::string. An entry bigger
+than the whole byte limit evicts everything else and stays alone.
+
+The cache counts hits, misses and evictions, so the hit ratio of a workload can
+be checked (a low ratio means the cache is too small for it).
+
+ Time Complexity
+ +------------+----------+----------+
+ | Operation  | Worst*   | Average  |
+ +------------+----------+----------+
+ | Get        | O(n)     | O(1)     |
+ | Put        | O(n)     | O(1)     |
+ | Evict      | O(1)     | O(1)     |
+ | Remove     | O(n)     | O(1)     |
+ +------------+----------+----------+
+ * the worst case is a bucket holding every key, as in any chaining table
+
+ Space complexity: O(n)
+
+*/
+
+// the default cost of an entry in bytes: the size of the key and the value,
+// plus the characters of a std::string
+struct EntryBytes {
+  template <typename T>
+  static size_t bytesOf(const T&) {
+    return sizeof(T);
+  }
+
+  static size_t bytesOf(const std::string& s) {
+    return sizeof(std::string) + s.size();
+  }
+
+  template <typename K, typename V>
+  size_t operator()(const K& key, const V& val) const {
+    return bytesOf(key) + bytesOf(val);
+  }
+};
+
+template <typename K, typename V, typename Hash = Mix64Hash,
+          typename Eq = std::equal_to<K>, typename Bytes = EntryBytes>
+class LRUCache {
+ private:
+  struct Node {
+    K key;
+    V val;
+    size_t bytes;
+    Node* chain;  // the next node in the same bucket
+    Node* prev;   // the more recently used neighbor
+    Node* next;   // the less recently used neighbor
+
+    // constructor
+    Node(const K& k, const V& v, size_t b)
+        : key(k), val(v), bytes(b), chain(nullptr), prev(nullptr),
+          next(nullptr) {}
+  };
+
+  std::vector<Node*> buckets;
+  NodePool<Node> pool;
+  Node* head;  // most recently used
+  Node* tail;  // least recently used
+  size_t count;
+  size_t bytes;
+  size_t maxEntries;
+  size_t maxBytes;
+  long long hits;
+  long long misses;
+  long long evictions;
+  Hash hasher;
+  Eq equal;
+  Bytes weigh;
+
+  size_t indexFor(const K& key) const {
+    return hasher(key) & (buckets.size() - 1);
+  }
+
+  Node* findNode(const K& key) const {
+    Node* curr = buckets[indexFor(key)];
+    while (curr && !equal(curr->key, key)) {
+      curr = curr->chain;
+    }
+    return curr;
+  }
+
+  // moves every node into a bucket array twice as big
+  void grow() {
+    std::vector<Node*> oldBuckets(buckets.size() * 2, nullptr);
+    oldBuckets.swap(buckets);
+
+    for (Node* curr : oldBuckets) {
+      while (curr) {
+        Node* chain = curr->chain;
+        size_t index = indexFor(curr->key);
+        curr->chain = buckets[index];
+        buckets[index] = curr;
+        curr = chain;
+      }
+    }
+  }
+
+  // takes the node out of the recency list
+  void unlink(Node* node) {
+    (node->prev ? node->prev->next : head) = node->next;
+    (node->next ? node->next->prev : tail) = node->prev;
+    node->prev = node->next = nullptr;
+  }
+
+  // puts the node at the head of the recency list
+  void pushFront(Node* node) {
+    node->next = head;
+    if (head) {
+      head->prev = node;
+    }
+    head = node;
+    if (!tail) {
+      tail = node;
+    }
+  }
+
+  // takes the node out of its bucket and the list, and frees it
+  void destroy(Node* node) {
+    Node** link = &buckets[indexFor(node->key)];
+    while (*link != node) {
+      link = &(*link)->chain;
+    }
+    *link = node->chain;
+
+    unlink(node);
+    count--;
+    bytes -= node->bytes;
+    pool.release(node);
+  }
+
+  bool overLimit() const {
+    return (maxEntries && count > maxEntries) || (maxBytes && bytes > maxBytes);
+  }
+
+  // evicts from the tail until the cache is within its limits, but never the
+  // node that was just used
+  void evict() {
+    while (overLimit() && tail != head) {
+      destroy(tail);
+      evictions++;
+    }
+  }
+
+ public:
+  // constructor, a limit of 0 means no limit, but one of them must be set
+  LRUCache(size_t entryLimit, size_t byteLimit = 0)
+      : buckets(8, nullptr),
+        head(nullptr),
+        tail(nullptr),
+        count(0),
+        bytes(0),
+        maxEntries(entryLimit),
+        maxBytes(byteLimit),
+        hits(0),
+        misses(0),
+        evictions(0) {
+    if (!maxEntries && !maxBytes) {
+      throw std::invalid_argument("Error! The cache needs a limit.\n");
+    }
+  }
+
+  // a cache owns its nodes, so it cannot be copied
+  LRUCache(const LRUCache&) = delete;
+  LRUCache& operator=(const LRUCache&) = delete;
+
+  // destructor
+  ~LRUCache() { clear(); }
+
+  // returns the value of the key and marks it as the most recently used, or
+  // nullptr if the key is not in the cache
+  V* get(const K& key) {
+    Node* node = findNode(key);
+    if (!node) {
+      misses++;
+      return nullptr;
+    }
+
+    hits++;
+    if (node != head) {
+      unlink(node);
+      pushFront(node);
+    }
+    return &node->val;
+  }
+
+  // returns the value of the key without marking it as used or counting it
+  const V* peek(const K& key) const {
+    Node* node = findNode(key);
+    return node ? &node->val : nullptr;
+  }
+
+  bool contains(const K& key) const { return findNode(key) != nullptr; }
+
+  // adds or replaces the value of the key, it becomes the most recently used.
+  // Returns true if the key is new
+  bool put(const K& key, const V& val) {
+    Node* node = findNode(key);
+    if (node) {
+      bytes -= node->bytes;
+      node->val = val;
+      node->bytes = weigh(key, val);
+      bytes += node->bytes;
+      if (node != head) {
+        unlink(node);
+        pushFront(node);
+      }
+      evict();
+      return false;
+    }
+
+    if (count + 1 > buckets.size()) {
+      grow();
+    }
+
+    node = pool.allocate(key, val, weigh(key, val));
+    size_t index = indexFor(key);
+    node->chain = buckets[index];
+    buckets[index] = node;
+    pushFront(node);
+    count++;
+    bytes += node->bytes;
+
+    evict();
+    return true;
+  }
+  /*
+
+  put(4) in a cache of 4 entries:
+
+    head                          tail
+    [3] <--> [12] <--> [7] <--> [5]
+
+    [4] <--> [3] <--> [12] <--> [7] <--> [5]     5 entries, over the limit
+
+    [4] <--> [3] <--> [12] <--> [7]              [5] is evicted
+
+  */
+
+  bool remove(const K& key) {
+    Node* node = findNode(key);
+    if (!node) {
+      return false;
+    }
+    destroy(node);
+    return true;
+  }
+
+  void clear() {
+    while (head) {
+      destroy(head);
+    }
+  }
+
+  // calls f(key, value) for every entry, from the most to the least recently
+  // used
+  template <typename F>
+  void forEach(F f) const {
+    for (Node* curr = head; curr; curr = curr->next) {
+      f(curr->key, curr->val);
+    }
+  }
+
+  size_t size() const { return count; }
+
+  size_t getBytes() const { return bytes; }
+
+  long long getHits() const { return hits; }
+
+  long long getMisses() const { return misses; }
+
+  long long getEvictions() const { return evictions; }
+
+  double hitRatio() const {
+    return hits + misses ? (double)hits / (hits + misses) : 0.0;
+  }
+
+  void resetStats() { hits = misses = evictions = 0; }
+
+  // number of nodes handed out by the pool, every put of a new key costs one
+  long long getNodeAllocations() const { return pool.getAllocations(); }
+
+  void printCache() const {
+    cout << "(newest) ";
+    for (Node* curr = head; curr; curr = curr->next) {
+      cout << curr->key << "-" << curr->val << " ";
+    }
+    cout << "(oldest)\n";
+  }
+
+  void printStats() const {
+    cout << "  entries: " << count;
+    if (maxEntries) {
+      cout << " of " << maxEntries;
+    }
+    cout << ", bytes: " << bytes;
+    if (maxBytes) {
+      cout << " of " << maxBytes;
+    }
+    cout << "\n  hits: " << hits << ", misses: " << misses
+         << ", evictions: " << evictions << ", hit ratio: " << hitRatio()
+         << "\n";
+  }
+};
+
+#endif
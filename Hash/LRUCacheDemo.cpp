@@ -0,0 +1,72 @@
+#include <string>
+
+#include "LRUCache.hpp"
+
+int main() {
+  // declaration
+  LRUCache<int, std::string> pages(4);  // at most 4 entries
+
+  int visits[] = {1, 2, 3, 1, 4, 5, 2, 1, 6};
+  for (int page : visits) {
+    if (pages.get(page)) {
+      cout << "...Page " << page << " is cached\n";
+    } else {
+      cout << "...Page " << page << " is loaded\n";
+      pages.put(page, "page" + std::to_string(page));
+    }
+  }
+
+  cout << "\nCache:\n";
+  pages.printCache();
+  cout << "\nStatistics:\n";
+  pages.printStats();
+
+  // a limit in bytes: every entry costs its key, its value and the characters
+  // of the value
+  LRUCache<std::string, std::string> files(0, 400);
+  files.put("a.txt", std::string(40, 'a'));
+  files.put("b.txt", std::string(40, 'b'));
+  files.put("c.txt", std::string(40, 'c'));
+  files.get("a.txt");
+  files.put("d.txt", std::string(60, 'd'));
+
+  cout << "\nFiles cached in 400 bytes:";
+  files.forEach([](const std::string& name, const std::string& data) {
+    cout << " " << name << " (" << data.size() << " chars)";
+  });
+  cout << "\n";
+  files.printStats();
+  cout << "\n";
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+...Page 1 is loaded
+...Page 2 is loaded
+...Page 3 is loaded
+...Page 1 is cached
+...Page 4 is loaded
+...Page 5 is loaded
+...Page 2 is loaded
+...Page 1 is cached
+...Page 6 is loaded
+
+Cache:
+(newest) 6-page6 1-page1 2-page2 5-page5 (oldest)
+
+Statistics:
+  entries: 4 of 4, bytes: 164
+  hits: 2, misses: 7, evictions: 3, hit ratio: 0.222222
+
+Files cached in 400 bytes: d.txt (60 chars) a.txt (40 chars) c.txt (40 chars)
+  entries: 3, bytes: 347 of 400
+  hits: 1, misses: 0, evictions: 1, hit ratio: 1
+
+Pages 3 and 4 were evicted, they were the least recently used when 5 and 6
+came in. In the file cache, a.txt was used after b.txt was added, so b.txt was
+the one evicted to make room for d.txt.
+
+*/
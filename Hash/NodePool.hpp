@@ -0,0 +1,121 @@
+#ifndef NODE_POOL
+#define NODE_POOL
+
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+
+A NodePool hands out memory for nodes of one type from big blocks called slabs,
+instead of asking the system allocator (new) for every node.
+
+  slab 0 (16 nodes)             slab 1 (32 nodes)
+  +----+----+----+-----+----+   +----+----+----+-----+----+
+  | n0 | n1 | n2 | ... | n15|   | n16| n17|    | ... |    |
+  +----+----+----+-----+----+   +----+----+----+-----+----+
+                                            ^
+                                        next unused
+
+ * allocate: take a node from the free list, or the next unused node of the
+   newest slab, or create a new slab (twice as big as the last one, up to
+   MAX_SLAB nodes)
+ * release: the node goes to the front of the free list, it is reused by the
+   next allocate
+
+  free list: n5 -> n1 -> n12 -> nullptr
+  (a free node stores the pointer to the next free node in its own memory)
+
+ * destructor: every slab is deleted at once, so throwing the pool away costs
+   O(number of slabs) instead of O(number of nodes). The pool does not run the
+   destructors of nodes that are still in use, that is the owner's job.
+
+Compared with new/delete per node:
+ * far fewer calls to the system allocator, and no lock contention inside it
+ * nodes of one table sit next to each other in memory
+
+*/
+
+template <typename T>
+class NodePool {
+ private:
+  static const int FIRST_SLAB = 16;
+  static const int MAX_SLAB = 1024;
+
+  // a free node reuses its memory to point to the next free node
+  union Slot {
+    Slot* next;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  std::vector<Slot*> slabs;
+  Slot* freeList;
+  int slabSize;  // number of nodes in the newest slab
+  int used;      // number of nodes of the newest slab handed out so far
+  size_t reserved;  // number of nodes in all the slabs
+  long long allocations;
+
+  Slot* nextSlot() {
+    if (freeList) {
+      Slot* slot = freeList;
+      freeList = freeList->next;
+      return slot;
+    }
+
+    // the newest slab is used up, get a bigger one
+    if (slabs.empty() || used == slabSize) {
+      slabSize = slabs.empty() ? FIRST_SLAB
+                               : (slabSize * 2 < MAX_SLAB ? slabSize * 2
+                                                          : MAX_SLAB);
+      slabs.push_back(new Slot[slabSize]);
+      reserved += slabSize;
+      used = 0;
+    }
+    return &slabs.back()[used++];
+  }
+
+ public:
+  // constructor
+  NodePool()
+      : freeList(nullptr), slabSize(0), used(0), reserved(0), allocations(0) {}
+
+  // a pool owns its slabs, so it cannot be copied
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  // destructor
+  ~NodePool() {
+    for (Slot* slab : slabs) {
+      delete[] slab;
+    }
+  }
+
+  // builds a node in pooled memory, passing the arguments to its constructor
+  template <typename... Args>
+  T* allocate(Args&&... args) {
+    Slot* slot = nextSlot();
+    allocations++;
+    return new (slot->storage) T(std::forward<Args>(args)...);
+  }
+
+  // destroys the node and keeps its memory for the next allocate
+  void release(T* node) {
+    node->~T();
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = freeList;
+    freeList = slot;
+  }
+
+  // number of nodes handed out since the pool was created
+  long long getAllocations() const { return allocations; }
+
+  // number of times the pool asked the system allocator for memory
+  int getSlabCount() const { return (int)slabs.size(); }
+
+  // the memory of the slabs, free nodes included
+  size_t getBytes() const {
+    return reserved * sizeof(Slot) + slabs.capacity() * sizeof(Slot*);
+  }
+};
+
+#endif
@@ -0,0 +1,75 @@
+#include "PerfectHashTable.cpp"
+
+int main() {
+  // declaration
+  std::vector<int> codes = {1, 7, 20, 30, 31, 33, 34, 39, 44, 49, 81, 86, 91};
+  std::vector<std::string> countries = {
+      "USA",         "Russia", "Egypt",   "Greece", "Netherlands",
+      "France",      "Spain",  "Romania", "UK",     "Germany",
+      "Japan",       "China",  "India"};
+
+  // the key set is fixed, so the table is built once (a fixed seed gives the
+  // same layout every run)
+  PerfectHashTable table(codes, countries, 2024);
+
+  cout << "\nTable (" << table.getCount() << " keys, " << table.getBytes()
+       << " bytes):\n";
+  table.printTable();
+
+  // save the table into a flat buffer and load it again, no rebuild needed
+  std::vector<char> buffer = table.serialize();
+  PerfectHashTable loaded(buffer);
+  cout << "\nSerialized into " << buffer.size() << " bytes and loaded again\n";
+
+  int lookups[] = {44, 81, 55};
+  std::string country;
+  cout << "\n";
+  for (int code : lookups) {
+    if (loaded.search(code, country)) {
+      cout << "...+" << code << " is " << country << " (slot "
+           << loaded.indexOf(code) << ")\n";
+    } else {
+      cout << "...+" << code << " not found!\n";
+    }
+  }
+
+  // a key set with a duplicate cannot be built
+  try {
+    PerfectHashTable broken({1, 2, 1}, {"a", "b", "c"});
+  } catch (const std::invalid_argument& error) {
+    cout << "\n" << error.what();
+  }
+  cout << "\n";
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+Table (13 keys, 191 bytes):
+Slot 0: 31 --> Netherlands
+Slot 1: 7 --> Russia
+Slot 2: 34 --> Spain
+Slot 3: 49 --> Germany
+Slot 4: 20 --> Egypt
+Slot 5: 33 --> France
+Slot 6: 44 --> UK
+Slot 7: 91 --> India
+Slot 8: 30 --> Greece
+Slot 9: 86 --> China
+Slot 10: 1 --> USA
+Slot 11: 81 --> Japan
+Slot 12: 39 --> Romania
+
+Serialized into 219 bytes and loaded again
+
+...+44 is UK (slot 6)
+...+81 is Japan (slot 11)
+...+55 not found!
+
+Error! Duplicate key.
+
+13 keys fill exactly 13 slots, and every search looked at one slot only.
+
+*/
@@ -0,0 +1,344 @@
+#include "PerfectHashTable.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+PerfectHashTable::PerfectHashTable(const std::vector<int>& keyList,
+                                   const std::vector<std::string>& vals,
+                                   uint64_t seed)
+    : hasher(seed) {
+  if (keyList.size() != vals.size()) {
+    throw std::invalid_argument("Error! Every key needs one value.\n");
+  }
+  if (keyList.size() >= (size_t)INT_MAX) {
+    throw std::length_error("Error! Too many keys.\n");
+  }
+
+  count = (int)keyList.size();
+  bucketCount = count / KEYS_PER_BUCKET + 1;
+  range = count + count / 64;
+
+  // slot[i] is where keyList[i] ends up. A bucket can (very rarely) find no
+  // seed at all, then we start over with another first hash
+  std::vector<int> slot;
+  while (!build(keyList, slot)) {
+    hasher = SeededHash(mix64(hasher.k1));
+  }
+
+  // lay out the keys and the values in slot order
+  std::vector<int> owner(count);
+  for (int i = 0; i < count; i++) {
+    owner[slot[i]] = i;
+  }
+
+  size_t bytes = 0;
+  for (const std::string& val : vals) {
+    bytes += val.size();
+  }
+  if (bytes > UINT32_MAX) {
+    throw std::length_error("Error! The values are too long.\n");
+  }
+
+  keys.resize(count);
+  offsets.resize(count + 1);
+  chars.reserve(bytes);
+  for (int i = 0; i < count; i++) {
+    keys[i] = keyList[owner[i]];
+    offsets[i] = (uint32_t)chars.size();
+    chars += vals[owner[i]];
+  }
+  offsets[count] = (uint32_t)chars.size();
+}
+
+uint64_t PerfectHashTable::hash(int key) const {
+  return hasher((uint64_t)key);
+}
+
+// the high 32 bits pick the bucket, with a multiply and a shift instead of a %
+int PerfectHashTable::bucketOf(uint64_t hashVal) const {
+  return (int)(((hashVal >> 32) * (uint64_t)bucketCount) >> 32);
+}
+
+// the slot of a key in a bucket with seed d: a remix of the key's hash with d,
+// mapped onto 0 .. range - 1 (so it can still be one of the extra slots)
+int PerfectHashTable::slotOf(uint64_t hashVal, int d) const {
+  uint64_t bits = mix64(hashVal + (uint64_t)d * 0x9E3779B97F4A7C15ULL);
+  return (int)(((bits & 0xFFFFFFFFULL) * (uint64_t)range) >> 32);
+}
+
+// finds a seed for every bucket, biggest buckets first. Fills slot with the
+// slot of every key, returns false if some bucket found no seed
+bool PerfectHashTable::build(const std::vector<int>& keyList,
+                             std::vector<int>& slot) {
+  std::vector<uint64_t> hashes(count);
+  std::vector<int> start(bucketCount + 1, 0);
+  for (int i = 0; i < count; i++) {
+    hashes[i] = hash(keyList[i]);
+    start[bucketOf(hashes[i]) + 1]++;
+  }
+
+  // group the keys by bucket (counting sort): the keys of bucket b are
+  // members[start[b] .. start[b + 1])
+  for (int b = 0; b < bucketCount; b++) {
+    start[b + 1] += start[b];
+  }
+  std::vector<int> members(count);
+  std::vector<int> next(start.begin(), start.end() - 1);
+  for (int i = 0; i < count; i++) {
+    members[next[bucketOf(hashes[i])]++] = i;
+  }
+
+  std::vector<int> order(bucketCount);
+  for (int b = 0; b < bucketCount; b++) {
+    order[b] = b;
+  }
+  std::stable_sort(order.begin(), order.end(), [&start](int a, int b) {
+    return start[a + 1] - start[a] > start[b + 1] - start[b];
+  });
+
+  seeds.assign(bucketCount, 0);
+  slot.assign(count, -1);
+  std::vector<bool> taken(range, false);
+  std::vector<int> tried;
+
+  for (int b : order) {
+    int first = start[b];
+    int length = start[b + 1] - first;
+
+    if (length == 0) {
+      break;  // the rest of the buckets are empty too
+    }
+
+    // two equal keys would never get two slots
+    for (int i = first; i < first + length; i++) {
+      for (int j = first; j < i; j++) {
+        if (keyList[members[i]] == keyList[members[j]]) {
+          throw std::invalid_argument("Error! Duplicate key.\n");
+        }
+      }
+    }
+
+    bool placed = false;
+    for (int d = 0; d <= UINT16_MAX && !placed; d++) {
+      // every key of the bucket needs a free slot, and a different one
+      tried.clear();
+      for (int i = first; i < first + length; i++) {
+        int index = slotOf(hashes[members[i]], d);
+        if (taken[index] ||
+            std::find(tried.begin(), tried.end(), index) != tried.end()) {
+          break;
+        }
+        tried.push_back(index);
+      }
+
+      if ((int)tried.size() == length) {
+        for (int i = 0; i < length; i++) {
+          taken[tried[i]] = true;
+          slot[members[first + i]] = tried[i];
+        }
+        seeds[b] = (uint16_t)d;
+        placed = true;
+      }
+    }
+
+    if (!placed) {
+      return false;
+    }
+  }
+
+  // as many keys landed on the extra slots as there are holes below count,
+  // pair them up. An extra slot without a key points anywhere, the key
+  // comparison of a search rejects it
+  remap.assign(range - count, 0);
+  std::vector<int> holes;
+  for (int i = 0; i < count; i++) {
+    if (!taken[i]) {
+      holes.push_back(i);
+    }
+  }
+  for (int i = count, next = 0; i < range; i++) {
+    if (taken[i]) {
+      remap[i - count] = holes[next++];
+    }
+  }
+  for (int& index : slot) {
+    if (index >= count) {
+      index = remap[index - count];
+    }
+  }
+
+  return true;
+}
+/*
+
+Building keys 12, 40, 7, 33, 95 (5 slots, 2 buckets, say d picks one of 6):
+
+  bucket 0: {12, 95, 33}    bucket 1: {40, 7}
+
+  bucket 0 first (3 keys):
+    d = 0:  slots 4, 1, 4   --> 4 twice, try again
+    d = 1:  slots 0, 2, 3   --> all free, seed[0] = 1
+
+  slot   |  0 |  1 |  2 |  3 |  4 || 5 |
+  key    | 12 |    | 95 | 33 |    ||   |
+                                    ^ extra slot
+  bucket 1 (2 keys):
+    d = 0:  slots 2, 4      --> 2 is taken
+    d = 1:  slots 1, 3      --> 3 is taken
+    d = 2:  slots 5, 1      --> both free, seed[1] = 2
+
+  slot   |  0 |  1 |  2 |  3 |  4 || 5 |
+  key    | 12 |  7 | 95 | 33 |    || 40|
+
+  slot 4 is a hole, so remap[0] = 4 and 40 is stored in slot 4:
+
+  slot   |  0 |  1 |  2 |  3 |  4 |
+  key    | 12 |  7 | 95 | 33 | 40 |
+
+The last buckets have few keys, so they still find free slots quickly even when
+the table is almost full, and the extra slots keep the last tries short.
+
+*/
+
+// returns the slot of the key, or -1 if the key is not in the set
+int PerfectHashTable::indexOf(int key) const {
+  if (count == 0) {
+    return -1;
+  }
+
+  uint64_t hashVal = hash(key);
+  int index = slotOf(hashVal, seeds[bucketOf(hashVal)]);
+  if (index >= count) {
+    index = remap[index - count];
+  }
+  return keys[index] == key ? index : -1;
+}
+
+bool PerfectHashTable::search(int key, std::string& val) const {
+  int index = indexOf(key);
+  if (index == -1) {
+    return false;
+  }
+
+  val.assign(chars, offsets[index], offsets[index + 1] - offsets[index]);
+  return true;
+}
+
+int PerfectHashTable::getCount() const { return count; }
+
+// the memory of the table itself: seeds, remap, keys, offsets and value bytes
+size_t PerfectHashTable::getBytes() const {
+  return seeds.size() * sizeof(uint16_t) + remap.size() * sizeof(int) +
+         keys.size() * sizeof(int) + offsets.size() * sizeof(uint32_t) +
+         chars.size();
+}
+
+// copies n values of type T to the end of the buffer
+template <typename T>
+static void appendRaw(std::vector<char>& buffer, const T* data, size_t n) {
+  size_t at = buffer.size();
+  buffer.resize(at + n * sizeof(T));
+  if (n) {
+    std::memcpy(&buffer[at], data, n * sizeof(T));
+  }
+}
+
+// copies n values of type T from the buffer at pos, and moves pos past them
+template <typename T>
+static void readRaw(const std::vector<char>& buffer, size_t& pos, T* data,
+                    size_t n) {
+  if (n > (buffer.size() - pos) / sizeof(T)) {
+    throw std::invalid_argument("Error! The buffer is too short.\n");
+  }
+  if (n) {
+    std::memcpy(data, &buffer[pos], n * sizeof(T));
+  }
+  pos += n * sizeof(T);
+}
+
+std::vector<char> PerfectHashTable::serialize() const {
+  std::vector<char> buffer;
+  buffer.reserve(3 * sizeof(uint32_t) + 2 * sizeof(uint64_t) + getBytes());
+
+  uint32_t header[3] = {MAGIC, (uint32_t)count, (uint32_t)bucketCount};
+  uint64_t hashSeeds[2] = {hasher.k0, hasher.k1};
+  appendRaw(buffer, header, 3);
+  appendRaw(buffer, hashSeeds, 2);
+  appendRaw(buffer, seeds.data(), seeds.size());
+  appendRaw(buffer, remap.data(), remap.size());
+  appendRaw(buffer, keys.data(), keys.size());
+  appendRaw(buffer, offsets.data(), offsets.size());
+  appendRaw(buffer, chars.data(), chars.size());
+  return buffer;
+}
+/*
+
+The buffer is every array of the table, back to back, in the byte order of the
+machine that wrote it:
+
+  +-------+-------+---------+-------+-------+-------+-------+------+---------+
+  | MAGIC | count | buckets |  k0   |  k1   | seeds | remap | keys | offsets |
+  +-------+-------+---------+-------+-------+-------+-------+------+---------+
+     4       4        4        8       8       |       |       |        |
+                                               |       |   4 * count    |
+                                     2 * buckets       |       4 * (count + 1)
+                                           4 * (count / 64)
+
+followed by the value bytes (chars). The number of buckets and the size of the
+remap array follow from count, so the loader can check them.
+
+*/
+
+PerfectHashTable::PerfectHashTable(const std::vector<char>& buffer)
+    : hasher(0) {
+  size_t pos = 0;
+  uint32_t header[3];
+  uint64_t hashSeeds[2];
+  readRaw(buffer, pos, header, 3);
+  readRaw(buffer, pos, hashSeeds, 2);
+
+  if (header[0] != MAGIC || header[1] >= (uint32_t)INT_MAX ||
+      header[2] != header[1] / KEYS_PER_BUCKET + 1) {
+    throw std::invalid_argument("Error! Not a perfect hash table.\n");
+  }
+
+  count = (int)header[1];
+  bucketCount = (int)header[2];
+  range = count + count / 64;
+  hasher.k0 = hashSeeds[0];
+  hasher.k1 = hashSeeds[1];
+
+  seeds.resize(bucketCount);
+  remap.resize(range - count);
+  keys.resize(count);
+  offsets.resize(count + 1);
+  readRaw(buffer, pos, seeds.data(), seeds.size());
+  readRaw(buffer, pos, remap.data(), remap.size());
+  readRaw(buffer, pos, keys.data(), keys.size());
+  readRaw(buffer, pos, offsets.data(), offsets.size());
+
+  // a broken buffer must not send a search outside the arrays
+  for (int index : remap) {
+    if (index < 0 || index >= count) {
+      throw std::invalid_argument("Error! Not a perfect hash table.\n");
+    }
+  }
+  for (int i = 0; i < count; i++) {
+    if (offsets[i] > offsets[i + 1]) {
+      throw std::invalid_argument("Error! Not a perfect hash table.\n");
+    }
+  }
+  if (offsets[0] != 0 || offsets[count] != buffer.size() - pos) {
+    throw std::invalid_argument("Error! Not a perfect hash table.\n");
+  }
+
+  chars.assign(buffer.begin() + pos, buffer.end());
+}
+
+void PerfectHashTable::printTable() const {
+  for (int i = 0; i < count; i++) {
+    cout << "Slot " << i << ": " << keys[i] << " --> "
+         << chars.substr(offsets[i], offsets[i + 1] - offsets[i]) << "\n";
+  }
+}
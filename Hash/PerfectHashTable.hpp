@@ -0,0 +1,114 @@
+#ifndef PERFECT_HASH_TABLE
+#define PERFECT_HASH_TABLE
+
+#include <cstdint>
+#include <iostream>  // preprocessor directive
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+A Perfect Hash Function maps every key of a fixed set to a different slot, so
+there are no collisions at all. A Minimal perfect hash function also uses
+exactly n slots for n keys: no slot is left empty.
+
+When the keys are known up front and never change (a configuration table, a
+dictionary), we can spend some time once to find such a function, and then
+every search is a single slot access:
+
+  keys: 12, 40, 7, 33, 95
+
+  slot  |  0 |  1 |  2 |  3 |  4 |
+  key   | 33 |  7 | 95 | 12 | 40 |   one key per slot, no empty slot
+
+Hash and Displace (CHD):
+Finding one function for all keys at once is hopeless, so the keys are first
+split into small buckets (about 3 keys each) by a first hash. Then, for every
+bucket, we look for a seed d such that hash(key, d) sends all keys of the
+bucket to slots that are still free. Only the seed of each bucket is stored.
+
+  bucket 0: {12, 95}  d = 3  --> slots 3, 2
+  bucket 1: {40, 7}   d = 1  --> slots 4, 1
+  bucket 2: {33}      d = 6  --> slot 0
+
+  search(key): b = bucket of key, slot = hash(key, seed[b]), compare keys[slot]
+
+ * The biggest buckets go first, while most slots are still free
+ * The last buckets look for the last free slots, which takes many tries. So
+   hash(key, d) picks from a few more slots than keys (about 1.5% more), and
+   a key that lands on one of those extra slots is sent to a hole below n by
+   a small remap array. The table still has exactly n slots
+ * The seeds are 16 bits, so the seed array is small enough to stay in the
+   cache and a search misses the cache only once, on its slot
+ * The table stores the keys too, so a key that is not in the set is found
+   out with one comparison
+
+ Time Complexity
+ +------------+-----------+-----------+
+ | Operation  | Worst     | Average   |
+ +------------+-----------+-----------+
+ | Build      | -         | O(n)      |
+ | Search     | O(1)      | O(1)      |
+ +------------+-----------+-----------+
+
+ Space complexity: O(n), 4 bytes per key for the key, 4 for the value offset
+ and less than 1 for the seeds and the remap array, plus the value bytes
+
+ Pros:
+ * Exactly one slot per search, no probing and no chains
+ * Small: no empty slots, no pointers, the values are stored back to back
+ * serialize writes the whole table into one flat buffer that can be saved to
+   a file and loaded again without building it again
+
+ Cons:
+ * Read-only: adding or removing a key means building a new table
+ * Building takes much longer than filling an ordinary hash table
+
+*/
+
+class PerfectHashTable {
+ private:
+  static const uint32_t MAGIC = 0x31544850;  // "PHT1" in a little-endian file
+  // fewer keys per bucket cost more seeds but build faster: with 3, a key needs
+  // about 11 tries to find its slot, with 4 about 30
+  static const int KEYS_PER_BUCKET = 3;
+
+  int count;
+  int bucketCount;
+  int range;          // hash(key, d) picks one of range >= count slots
+  SeededHash hasher;  // the first hash
+  std::vector<uint16_t> seeds;  // the seed d of every bucket
+  std::vector<int> remap;       // slot count + i is really slot remap[i]
+  std::vector<int> keys;        // keys[slot]
+  std::vector<uint32_t> offsets;  // the value of slot i is
+  std::string chars;              // chars[offsets[i] .. offsets[i + 1])
+
+  uint64_t hash(int) const;
+  int bucketOf(uint64_t) const;
+  int slotOf(uint64_t, int) const;
+  bool build(const std::vector<int>&, std::vector<int>&);
+
+ public:
+  // constructor: builds the table from the keys and their values
+  PerfectHashTable(const std::vector<int>&, const std::vector<std::string>&,
+                   uint64_t = randomSeed());
+
+  // constructor: loads a table written by serialize
+  PerfectHashTable(const std::vector<char>&);
+
+  int indexOf(int) const;
+  bool search(int, std::string&) const;
+  std::vector<char> serialize() const;
+
+  int getCount() const;
+  size_t getBytes() const;
+  void printTable() const;
+};
+
+#endif
@@ -0,0 +1,203 @@
+#include "RobinHoodHashTable.hpp"
+
+RobinHoodHashTable::RobinHoodHashTable(int tableSize)
+    : size(tableSize),
+      count(0),
+      table(tableSize, 0),
+      distances(tableSize, EMPTY) {}
+/*
+
+For example, tableSize = 5:
+
+            0     1     2     3     4
+         +-----+-----+-----+-----+-----+
+  Table  |     |     |     |     |     |
+         +-----+-----+-----+-----+-----+
+  Dist   |  E  |  E  |  E  |  E  |  E  |  (E: empty)
+         +-----+-----+-----+-----+-----+
+
+*/
+
+// division hashing, normalized so that negative keys also land in the table
+int RobinHoodHashTable::hash(int key) { return ((key % size) + size) % size; }
+
+int RobinHoodHashTable::getSize() const { return size; }
+
+int RobinHoodHashTable::getCount() const { return count; }
+
+bool RobinHoodHashTable::add(int key) {
+  // the key is already in the table, nothing to do
+  if (search(key) != -1) {
+    return true;
+  }
+
+  if (count == size) {
+    return false;
+  }
+
+  int index = hash(key);
+  int dist = 0;
+
+  while (true) {
+    // found an empty slot, drop the key here
+    if (distances[index] == EMPTY) {
+      table[index] = key;
+      distances[index] = dist;
+      count++;
+      return true;
+    }
+
+    // the key in this slot is closer to its home than we are, so we take its
+    // slot and keep probing with the evicted key
+    if (distances[index] < dist) {
+      std::swap(key, table[index]);
+      std::swap(dist, distances[index]);
+    }
+
+    index = (index + 1) % size;
+    dist++;
+  }
+}
+/*
+
+Here is the table (size 10), keys 10 and 20 both hash to 0:
+
+            0     1     2     3     4     5
+         +-----+-----+-----+-----+-----+-----+
+  Table  | 10  | 20  |  2  |     |     | ... |
+         +-----+-----+-----+-----+-----+-----+
+  Dist   |  0  |  1  |  0  |  E  |  E  | ... |
+         +-----+-----+-----+-----+-----+-----+
+
+Add 30 (home slot 0):
+
+  index 0: dist 0 vs 0, keep going
+  index 1: dist 1 vs 1, keep going
+  index 2: dist 2 vs 0, 2 is richer than 30! Swap them and carry 2 onward
+
+            0     1     2     3     4     5
+         +-----+-----+-----+-----+-----+-----+
+  Table  | 10  | 20  | 30  |     |     | ... |
+         +-----+-----+-----+-----+-----+-----+
+  Dist   |  0  |  1  |  2  |  E  |  E  | ... |
+         +-----+-----+-----+-----+-----+-----+
+                        ^
+                    now we carry 2 (dist 1)
+
+  index 3: empty, drop 2 here
+
+            0     1     2     3     4     5
+         +-----+-----+-----+-----+-----+-----+
+  Table  | 10  | 20  | 30  |  2  |     | ... |
+         +-----+-----+-----+-----+-----+-----+
+  Dist   |  0  |  1  |  2  |  1  |  E  | ... |
+         +-----+-----+-----+-----+-----+-----+
+
+With plain linear probing, 30 would sit at index 3 with distance 3 and 2 would
+keep distance 0. Robin Hood spreads the cost: the longest distance is 2.
+
+*/
+
+int RobinHoodHashTable::search(int key) {
+  int index = hash(key);
+  int dist = 0;
+
+  // keys along a cluster are ordered by their home slot, so once we meet a key
+  // that is closer to its home than we are, our key cannot be further away
+  while (dist < size && distances[index] != EMPTY && dist <= distances[index]) {
+    if (table[index] == key) {
+      return index;
+    }
+    index = (index + 1) % size;
+    dist++;
+  }
+
+  return -1;
+}
+/*
+
+            0     1     2     3     4     5
+         +-----+-----+-----+-----+-----+-----+
+  Table  | 10  | 20  | 30  |  2  |  4  | ... |
+         +-----+-----+-----+-----+-----+-----+
+  Dist   |  0  |  1  |  2  |  1  |  0  | ... |
+         +-----+-----+-----+-----+-----+-----+
+
+Searching 12 (home slot 2):
+
+  index 2: dist 0 vs 2, not 12, keep going
+  index 3: dist 1 vs 1, not 12, keep going
+  index 4: dist 2 vs 0, if 12 were here, it would have taken this slot
+           already. Stop early and return -1.
+
+Plain linear probing has to walk until it finds an empty slot.
+
+*/
+
+bool RobinHoodHashTable::remove(int key) {
+  int index = search(key);
+
+  if (index == -1) {
+    return false;
+  }
+
+  // backward-shift deletion: pull every following key of the cluster one slot
+  // closer to its home until we meet an empty slot or a key already at home
+  int next = (index + 1) % size;
+  while (distances[next] != EMPTY && distances[next] > 0) {
+    table[index] = table[next];
+    distances[index] = distances[next] - 1;
+    index = next;
+    next = (next + 1) % size;
+  }
+
+  distances[index] = EMPTY;
+  count--;
+  return true;
+}
+/*
+
+            0     1     2     3     4     5
+         +-----+-----+-----+-----+-----+-----+
+  Table  | 10  | 20  | 30  |  2  |  4  | ... |
+         +-----+-----+-----+-----+-----+-----+
+  Dist   |  0  |  1  |  2  |  1  |  0  | ... |
+         +-----+-----+-----+-----+-----+-----+
+
+Removing 20:
+
+            0     1     2     3     4     5
+         +-----+-----+-----+-----+-----+-----+
+  Table  | 10  | 30  |  2  |  2  |  4  | ... |
+         +-----+-----+-----+-----+-----+-----+
+  Dist   |  0  |  1  |  0  |  1  |  0  | ... |
+         +-----+-----+-----+-----+-----+-----+
+                  ^     ^
+        30 and 2 move one slot backward
+
+  index 4 holds 4 with distance 0, it is already at home. Stop and mark the
+  last moved slot as empty.
+
+            0     1     2     3     4     5
+         +-----+-----+-----+-----+-----+-----+
+  Table  | 10  | 30  |  2  |     |  4  | ... |
+         +-----+-----+-----+-----+-----+-----+
+  Dist   |  0  |  1  |  0  |  E  |  0  | ... |
+         +-----+-----+-----+-----+-----+-----+
+
+No "dirty" slot is left behind, so the cluster becomes shorter instead of
+staying as long as before.
+
+*/
+
+void RobinHoodHashTable::printTable() {
+  for (int i = 0; i < size; i++) {
+    cout << "Index " << i << ": ";
+    if (distances[i] == EMPTY) {
+      cout << "(Empty)";
+    } else {
+      cout << table[i] << " (dist " << distances[i] << ")";
+    }
+    cout << "\n";
+  }
+}
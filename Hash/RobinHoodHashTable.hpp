@@ -0,0 +1,76 @@
+#ifndef ROBIN_HOOD_HASH_TABLE
+#define ROBIN_HOOD_HASH_TABLE
+
+#include <iostream>  // preprocessor directive
+#include <vector>
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+Robin Hood Hashing is a variant of linear probing (Check the HashTable.cpp).
+Every key remembers how far it is from its home slot, which is called the probe
+distance (or "distance to initial bucket", DIB).
+
+When we insert a key and meet a key that is closer to its home than we are, we
+take its slot ("steal from the rich") and keep probing with the evicted key
+instead ("give to the poor"). As a result, every key ends up roughly the same
+distance away from its home slot.
+
+ Key Characteristics
+ * Open addressing with linear probing
+ * Each slot stores the key and its probe distance
+ * Keys along a cluster are sorted by their home slot
+ * No tombstones: deletion shifts the following keys one slot backward
+
+ Time Complexity
+ +------------+----------+----------+
+ | Operation  | Worst*   | Average  |
+ +------------+----------+----------+
+ | Search     | O(n)     | O(1)     |
+ | Insertion  | O(n)     | O(1)     |
+ | Deletion   | O(n)     | O(1)     |
+ +------------+----------+----------+
+ * The worst case still exists, but the variance of the probe distance is much
+   smaller than plain linear probing, so the slow lookups are rare.
+
+ Space complexity: O(n)
+
+ Pros:
+ * Low variance of probe lengths, so lookup latency stays flat
+ * A search for a missing key can stop early (see search)
+ * Deletion never leaves tombstones behind, so the table does not degrade after
+   many inserts and deletes
+
+ Cons:
+ * Extra memory for the probe distance of every slot
+ * Insertion moves keys around, so an index returned by search is only valid
+   until the next add or remove
+
+*/
+
+class RobinHoodHashTable {
+ private:
+  static constexpr int EMPTY = -1;  // marks an empty slot in distances
+
+  int size;
+  int count;
+  std::vector<int> table;
+  std::vector<int> distances;  // probe distance of each slot
+
+ public:
+  RobinHoodHashTable(int);
+
+  int hash(int);
+
+  bool add(int);
+  bool remove(int);
+  int search(int);
+
+  int getSize() const;
+  int getCount() const;
+  void printTable();
+};
+
+#endif
@@ -0,0 +1,202 @@
+#include "SwissTable.hpp"
+
+SwissTable::SwissTable(int tableSize) : count(0), deleted(0) {
+  // round up to a power of two, and never fewer slots than one group
+  size = GROUP_SIZE;
+  while (size < tableSize) {
+    size *= 2;
+  }
+  control.assign(size, EMPTY);
+  slots.assign(size, 0);
+}
+
+uint64_t SwissTable::hash(int key) const { return mix64((uint64_t)key); }
+
+int SwissTable::getSize() const { return size; }
+
+int SwissTable::getCount() const { return count; }
+
+// returns a bit mask: bit i is set if control byte i of the group equals h2
+uint32_t SwissTable::match(int group, int8_t h2) const {
+#if defined(__SSE2__)
+  __m128i bytes = _mm_loadu_si128((const __m128i*)&control[group * GROUP_SIZE]);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), bytes));
+#else
+  uint32_t mask = 0;
+  for (int i = 0; i < GROUP_SIZE; i++) {
+    if (control[group * GROUP_SIZE + i] == h2) {
+      mask |= 1u << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+uint32_t SwissTable::matchEmpty(int group) const { return match(group, EMPTY); }
+
+// empty and deleted bytes are the only ones with the highest bit set, so the
+// SSE2 version just collects the highest bit of every byte
+uint32_t SwissTable::matchEmptyOrDeleted(int group) const {
+#if defined(__SSE2__)
+  __m128i bytes = _mm_loadu_si128((const __m128i*)&control[group * GROUP_SIZE]);
+  return _mm_movemask_epi8(bytes);
+#else
+  uint32_t mask = 0;
+  for (int i = 0; i < GROUP_SIZE; i++) {
+    if (control[group * GROUP_SIZE + i] < 0) {
+      mask |= 1u << i;
+    }
+  }
+  return mask;
+#endif
+}
+/*
+
+match(group, 0x5a):
+
+  control   | 5a | 80 | 13 | 5a | fe | 80 | 77 | 80 | ...
+  h2 x 16   | 5a | 5a | 5a | 5a | 5a | 5a | 5a | 5a | ...
+            +----+----+----+----+----+----+----+----+
+  cmpeq     | ff | 00 | 00 | ff | 00 | 00 | 00 | 00 | ...
+  movemask    1    0    0    1    0    0    0    0     --> 0b...1001
+
+Then we walk the set bits of the mask from the lowest one:
+
+  mask & -mask   keeps the lowest set bit
+  mask & (mask - 1)  clears it
+
+*/
+
+// returns the first slot along the probe sequence that is empty or deleted
+int SwissTable::findSlot(uint64_t hashVal) const {
+  int groups = size / GROUP_SIZE;
+  int group = (int)((hashVal >> 7) & (groups - 1));
+
+  for (int step = 1; step <= groups; step++) {
+    uint32_t mask = matchEmptyOrDeleted(group);
+    if (mask) {
+      return group * GROUP_SIZE + __builtin_ctz(mask);
+    }
+    group = (group + step) & (groups - 1);
+  }
+
+  return -1;
+}
+
+// moves every key into a table of the given size
+void SwissTable::rehash(int newSize) {
+  std::vector<int8_t> oldControl(newSize, EMPTY);
+  std::vector<int> oldSlots(newSize, 0);
+  oldControl.swap(control);
+  oldSlots.swap(slots);
+
+  size = newSize;
+  deleted = 0;
+
+  // deleted bytes are simply left behind
+  for (size_t i = 0; i < oldControl.size(); i++) {
+    if (oldControl[i] >= 0) {
+      uint64_t hashVal = hash(oldSlots[i]);
+      int index = findSlot(hashVal);
+      control[index] = (int8_t)(hashVal & 0x7f);
+      slots[index] = oldSlots[i];
+    }
+  }
+}
+
+bool SwissTable::add(int key) {
+  // every key is stored only once
+  if (search(key) != -1) {
+    return false;
+  }
+
+  // keep at least 1/8 of the slots empty, so that searches can stop early
+  if ((count + deleted + 1) * 8 > size * 7) {
+    // grow if the keys take most of the space, otherwise just clean up
+    rehash((count + 1) * 16 > size * 7 ? size * 2 : size);
+  }
+
+  uint64_t hashVal = hash(key);
+  int index = findSlot(hashVal);
+
+  if (control[index] == DELETED) {
+    deleted--;
+  }
+  control[index] = (int8_t)(hashVal & 0x7f);
+  slots[index] = key;
+  count++;
+  return true;
+}
+
+int SwissTable::search(int key) const {
+  uint64_t hashVal = hash(key);
+  int8_t h2 = (int8_t)(hashVal & 0x7f);
+  int groups = size / GROUP_SIZE;
+  int group = (int)((hashVal >> 7) & (groups - 1));
+
+  for (int step = 1; step <= groups; step++) {
+    // compare the real keys only where the 7-bit fragment matches
+    uint32_t mask = match(group, h2);
+    while (mask) {
+      int index = group * GROUP_SIZE + __builtin_ctz(mask);
+      if (slots[index] == key) {
+        return index;
+      }
+      mask &= mask - 1;
+    }
+
+    // an empty slot means the key was never pushed past this group
+    if (matchEmpty(group)) {
+      return -1;
+    }
+    group = (group + step) & (groups - 1);
+  }
+
+  return -1;
+}
+/*
+
+Searching a key with H1 pointing at group 2 and H2 = 0x31:
+
+  group 2: | 31 | 0c | ... | 31 | ... |  two candidates, neither is our key
+           no empty byte in the group, keep going
+
+  group 3: | 44 | E  | ... |  no candidate and an empty byte
+
+When our key was added, group 3 had an empty slot and it would have been put
+there. So the key is not in the table. Return -1 after looking at 2 groups.
+
+*/
+
+bool SwissTable::remove(int key) {
+  int index = search(key);
+
+  if (index == -1) {
+    return false;
+  }
+
+  // if the group still has an empty slot, it was never full, so no search ever
+  // went past it and the slot can become empty again
+  if (matchEmpty(index / GROUP_SIZE)) {
+    control[index] = EMPTY;
+  } else {
+    control[index] = DELETED;
+    deleted++;
+  }
+  count--;
+  return true;
+}
+
+void SwissTable::printTable() const {
+  for (int i = 0; i < size; i++) {
+    cout << "Index " << i << ": ";
+    if (control[i] == EMPTY) {
+      cout << "(Empty)";
+    } else if (control[i] == DELETED) {
+      cout << "(Deleted)";
+    } else {
+      cout << slots[i] << " (h2 " << (int)control[i] << ")";
+    }
+    cout << "\n";
+  }
+}
@@ -0,0 +1,98 @@
+#ifndef SWISS_TABLE
+#define SWISS_TABLE
+
+#include <cstdint>
+#include <iostream>  // preprocessor directive
+#include <vector>
+
+#include "HashFunctions.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using std::cin;  // using declaration
+using std::cout;
+
+/*
+
+A Swiss Table is an open-addressing hash table (like HashTable.cpp) that keeps a
+separate array of one-byte "control" values next to the slots. The control byte
+tells whether a slot is empty, deleted, or full, and for full slots it also
+stores 7 bits of the key's hash.
+
+  hash(key) = mix64(key)
+              +--------------------------------------+---------+
+              |           H1 (upper 57 bits)         | H2 (7)  |
+              +--------------------------------------+---------+
+                  which group to start probing at      stored in the control byte
+
+The slots are split into groups of 16. One SSE2 instruction compares H2 against
+all 16 control bytes of a group at once and returns a 16-bit mask of the
+candidates. Only those candidates are compared with the real key.
+
+  group 0
+  +----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+
+  | 5a | E  | 13 | 5a | D  | E  | 77 | E  | E  | 02 | E  | E  | 31 | E  | E  | E  |
+  +----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+----+
+    ^              ^
+  H2 = 5a matches slot 0 and slot 3, so we only look at those two keys
+  (E: empty, D: deleted)
+
+A search for a missing key usually stops at the first group: if the group has an
+empty slot and none of the control bytes match, the key cannot be anywhere else.
+
+ Key Characteristics
+ * Open addressing, one byte of metadata per slot
+ * Probes 16 slots per step instead of one
+ * Groups are visited in a triangular sequence (g, g + 1, g + 3, g + 6, ...)
+ * The table grows when it is 7/8 full
+
+ Time Complexity
+ +------------+----------+----------+
+ | Operation  | Worst*   | Average  |
+ +------------+----------+----------+
+ | Search     | O(n)     | O(1)     |
+ | Insertion  | O(n)     | O(1)     |
+ | Deletion   | O(n)     | O(1)     |
+ +------------+----------+----------+
+ * Two keys share an H2 value with probability 1/128, so a lookup rarely
+   compares more than one key, even at high load factors.
+
+ Space complexity: O(n), one extra byte per slot
+
+*/
+
+class SwissTable {
+ private:
+  static constexpr int GROUP_SIZE = 16;
+  static constexpr int8_t EMPTY = -128;  // 0b10000000
+  static constexpr int8_t DELETED = -2;  // 0b11111110
+
+  int size;     // number of slots, a power of two, at least GROUP_SIZE
+  int count;    // number of keys
+  int deleted;  // number of deleted control bytes
+  std::vector<int8_t> control;
+  std::vector<int> slots;
+
+  uint32_t match(int, int8_t) const;
+  uint32_t matchEmpty(int) const;
+  uint32_t matchEmptyOrDeleted(int) const;
+  int findSlot(uint64_t) const;
+  void rehash(int);
+
+ public:
+  SwissTable(int = GROUP_SIZE);
+
+  uint64_t hash(int) const;
+
+  bool add(int);
+  bool remove(int);
+  int search(int) const;
+
+  int getSize() const;
+  int getCount() const;
+  void printTable() const;
+};
+
+#endif
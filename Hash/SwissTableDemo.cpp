@@ -0,0 +1,69 @@
+#include "SwissTable.cpp"
+
+int main() {
+  // declaration
+  SwissTable table;  // one group of 16 slots
+  int keys[] = {1, 2, 3, 4, 5, 42, 100, 2024};
+
+  for (int key : keys) {
+    table.add(key);
+  }
+  table.remove(3);
+
+  cout << "\nTable (" << table.getCount() << " keys, " << table.getSize()
+       << " slots):\n";
+  table.printTable();
+
+  int lookups[] = {42, 3, 7};
+  cout << "\n";
+  for (int key : lookups) {
+    int index = table.search(key);
+    if (index != -1) {
+      cout << "...Found " << key << " at index " << index << "\n";
+    } else {
+      cout << "...Number " << key << " not found!\n";
+    }
+  }
+
+  // the 15th key pushes the table over 7/8 full, so it doubles
+  for (int key = 10; key < 18; key++) {
+    table.add(key);
+  }
+  cout << "\nAfter adding 10 to 17: " << table.getCount() << " keys, "
+       << table.getSize() << " slots\n\n";
+
+  return 0;
+}
+
+// Sample Output
+/*
+
+Table (7 keys, 16 slots):
+Index 0: 1 (h2 44)
+Index 1: 2 (h2 103)
+Index 2: (Empty)
+Index 3: 4 (h2 117)
+Index 4: 5 (h2 117)
+Index 5: 42 (h2 76)
+Index 6: 100 (h2 98)
+Index 7: 2024 (h2 83)
+Index 8: (Empty)
+Index 9: (Empty)
+Index 10: (Empty)
+Index 11: (Empty)
+Index 12: (Empty)
+Index 13: (Empty)
+Index 14: (Empty)
+Index 15: (Empty)
+
+...Found 42 at index 5
+...Number 3 not found!
+...Number 7 not found!
+
+After adding 10 to 17: 15 keys, 32 slots
+
+With only one group, every key lands in the first empty or deleted slot. 3 was
+removed while the group still had empty slots, so its slot became empty again
+instead of deleted.
+
+*/
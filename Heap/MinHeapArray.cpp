@@ -1,6 +1,8 @@
 #include <iostream>  // preprocessor directive
 #include <vector>
 
+#include "MinHeap.hpp"
+
 using std::cin;  // using declaration
 using std::cout;
 
@@ -70,95 +72,6 @@ store the tree nodes in an array using level-order traversal.
 
 */
 
-template <typename T>
-class MinHeap {
- public:
-  void insert(T newData) {
-    heap.push_back(newData);
-    // maintain heap property
-    heapifyUp(size() - 1);
-  }
-
-  T extractMin() {
-    if (isEmpty()) {
-      throw std::out_of_range("Error! Heap is empty.\n");
-    }
-
-    T min = heap[0];
-
-    // move last element to root
-    heap[0] = heap.back();
-    // remove last element
-    heap.pop_back();
-
-    if (!isEmpty()) {
-      // maintain heap property
-      heapifyDown(0);
-    }
-
-    return min;
-  }
-
-  T getMin() const {
-    if (isEmpty()) {
-      throw std::out_of_range("Error! Heap is empty.\n");
-    }
-
-    // root is always the minimum in a min heap
-    return heap[0];
-  }
-
-  bool isEmpty() const { return heap.empty(); }
-
-  size_t size() const { return heap.size(); }
-
-  void printHeap() const {
-    if (isEmpty()) {
-      cout << "(Empty)";
-    }
-    for (T val : heap) {
-      cout << val << " ";
-    }
-    cout << "\n";
-  }
-
- private:
-  std::vector<T> heap;
-
-  // maintains heap property by moving an element up
-  void heapifyUp(int index) {
-    while (index > 0 && heap[(index - 1) / 2] > heap[index]) {
-      std::swap(heap[index], heap[(index - 1) / 2]);
-      index = (index - 1) / 2;
-    }
-  }
-
-  // maintains heap property by moving an element down
-  void heapifyDown(int index) {
-    int minIndex = index;
-    int left = 2 * index + 1;   // left child
-    int right = 2 * index + 2;  // right child
-
-    // check if left child is smaller
-    if (left < heap.size() && heap[left] < heap[minIndex]) {
-      minIndex = left;
-    }
-
-    // check if right child is smaller
-    if (right < heap.size() && heap[right] < heap[minIndex]) {
-      minIndex = right;
-    }
-
-    // if a child is smaller, swap and continue heapifying
-    if (minIndex != index) {
-      std::swap(heap[index], heap[minIndex]);
-
-      // recursively heapify the affected subtree
-      heapifyDown(minIndex);
-    }
-  }
-};
-
 int main() {
   // declaration
   MinHeap<int> heap;